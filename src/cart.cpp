@@ -31,12 +31,16 @@
 
 #include "file.h"
 #include "utils/memory.h"
+#include "utils/crc32.h"
+#include "utils/asyncio.h"
 
 
 #include <cstring>
 #include <cstdlib>
 #include <cstdio>
 #include <climits>
+#include <vector>
+#include <atomic>
 
 uint8 *Page[32], *VPage[8];
 uint8 **VPageR = VPage;
@@ -529,21 +533,94 @@ void FCEU_GeniePower(void) {
 }
 
 
+// Battery-backed RAM is also written while the game runs, so a crash or a
+// flat battery doesn't lose the progress: every SAVEGAME_CHECK_FRAMES frames
+// the SaveGame buffers are hashed and, if they differ from the file, a copy
+// goes to the background writer. A change that has stopped changing is
+// written at the next check; games that use the RAM as scratch space and
+// change it all the time are written at most every SAVEGAME_MIN_FRAMES, to
+// spare the SD card.
+#define SAVEGAME_CHECK_FRAMES	300		// about five seconds
+#define SAVEGAME_MIN_FRAMES		3600	// about a minute
+
+static CartInfo *saveGameCart = NULL;	// the running game's, while it has a battery
+static std::atomic<uint32> saveGameDiskCRC;	// of what is on disk, set once a write succeeded
+static std::atomic<bool> saveGameWriting;	// a periodic write is queued or running
+static uint32 saveGameLastCRC;			// at the previous check
+static int saveGameFrames;
+static int saveGameSinceWrite;			// frames since the last periodic write
+
+static uint32 SaveGameCRC(CartInfo *LocalHWInfo) {
+	uint32 crc = 0;
+	for (int x = 0; x < 4; x++)
+		if (LocalHWInfo->SaveGame[x])
+			crc = CalcCRC32(crc, LocalHWInfo->SaveGame[x], LocalHWInfo->SaveGameLen[x]);
+	return crc;
+}
+
+static void SaveGameCopy(CartInfo *LocalHWInfo, std::vector<uint8> &data) {
+	for (int x = 0; x < 4; x++)
+		if (LocalHWInfo->SaveGame[x])
+			data.insert(data.end(), LocalHWInfo->SaveGame[x], LocalHWInfo->SaveGame[x] + LocalHWInfo->SaveGameLen[x]);
+}
+
+class SAVEGAMEWRITEJOB : public ASYNCJOB
+{
+public:
+	std::string fname;
+	std::vector<uint8> data;
+	uint32 crc;
+
+	virtual void run() {
+		if (FCEU_WriteFileAtomic(fname.c_str(), data.empty() ? NULL : &data[0], data.size()))
+			saveGameDiskCRC = crc;
+		else
+			FCEU_printf("WRAM file \"%s\" cannot be written to.\n", fname.c_str());
+		// a failed write leaves the old CRC, so the next check tries again
+		saveGameWriting = false;
+	}
+};
+
+// Called once per emulated frame
+void FCEU_SaveGameUpdate(void) {
+	if (!saveGameCart)
+		return;
+	if (saveGameSinceWrite < SAVEGAME_MIN_FRAMES)
+		saveGameSinceWrite++;
+	if (++saveGameFrames < SAVEGAME_CHECK_FRAMES || saveGameWriting)
+		return;
+	saveGameFrames = 0;
+
+	uint32 crc = SaveGameCRC(saveGameCart);
+	bool settled = crc == saveGameLastCRC;
+	saveGameLastCRC = crc;
+	if (crc == saveGameDiskCRC || (!settled && saveGameSinceWrite < SAVEGAME_MIN_FRAMES))
+		return;
+	saveGameSinceWrite = 0;
+
+	SAVEGAMEWRITEJOB *job = new SAVEGAMEWRITEJOB();
+	job->fname = FCEU_MakeFName(FCEUMKF_SAV, 0, "sav");
+	job->crc = crc;
+	SaveGameCopy(saveGameCart, job->data);
+	saveGameWriting = true;
+	FCEU_AsyncSubmit(job);
+}
+
 void FCEU_SaveGameSave(CartInfo *LocalHWInfo) {
 	if (LocalHWInfo->battery && LocalHWInfo->SaveGame[0]) {
-		FILE *sp;
-
-		std::string soot = FCEU_MakeFName(FCEUMKF_SAV, 0, "sav");
-		if ((sp = FCEUD_UTF8fopen(soot, "wb")) == NULL) {
-			FCEU_PrintError("WRAM file \"%s\" cannot be written to.\n", soot.c_str());
-		} else {
-			for (int x = 0; x < 4; x++)
-				if (LocalHWInfo->SaveGame[x]) {
-					fwrite(LocalHWInfo->SaveGame[x], 1,
-						   LocalHWInfo->SaveGameLen[x], sp);
-				}
+		// a periodic write still queued mustn't land after this one; waiting
+		// only waits, so a failed state save is still FCEUSS_WaitSaves' to report
+		FCEU_AsyncWait();
+		if (!(saveGameCart == LocalHWInfo && SaveGameCRC(LocalHWInfo) == saveGameDiskCRC)) {
+			std::vector<uint8> data;
+			SaveGameCopy(LocalHWInfo, data);
+
+			std::string soot = FCEU_MakeFName(FCEUMKF_SAV, 0, "sav");
+			if (!FCEU_WriteFileAtomic(soot.c_str(), data.empty() ? NULL : &data[0], data.size()))
+				FCEU_PrintError("WRAM file \"%s\" cannot be written to.\n", soot.c_str());
 		}
 	}
+	saveGameCart = NULL;
 }
 
 // hack, movie.cpp has to communicate with this function somehow
@@ -559,8 +636,17 @@ void FCEU_LoadGameSave(CartInfo *LocalHWInfo) {
 			for (int x = 0; x < 4; x++)
 				if (LocalHWInfo->SaveGame[x])
 					fread(LocalHWInfo->SaveGame[x], 1, LocalHWInfo->SaveGameLen[x], sp);
+			fclose(sp);
 		}
 	}
+
+	if (LocalHWInfo->battery && LocalHWInfo->SaveGame[0]) {
+		saveGameCart = LocalHWInfo;
+		saveGameDiskCRC = saveGameLastCRC = SaveGameCRC(LocalHWInfo);
+		saveGameWriting = false;
+		saveGameFrames = 0;
+		saveGameSinceWrite = 0;
+	}
 }
 
 //clears all save memory. call this if you want to pretend the saveram has been reset (it doesnt touch what is on disk though)
@@ -26,6 +26,7 @@ typedef struct {
 } CartInfo;
 
 void FCEU_SaveGameSave(CartInfo *LocalHWInfo);
+void FCEU_SaveGameUpdate(void);
 void FCEU_LoadGameSave(CartInfo *LocalHWInfo);
 void FCEU_ClearGameSave(CartInfo *LocalHWInfo);
 
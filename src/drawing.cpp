@@ -4,6 +4,7 @@
 #include "video.h"
 #include "movie.h"
 #include "driver.h"
+#include "runahead.h"
 
 static uint8 Font6x7[792] =
 {
@@ -107,6 +108,7 @@ static uint8 Font6x7[792] =
 void DrawTextLineBG(uint8 *dest)
 {
 	int x,y;
+	FCEU_BeginOverlay();
 	static int otable[7]={81,49,30,17,8,3,0};
 	//100,40,15,10,7,5,2};
 	for(y=0;y<14;y++)
@@ -134,7 +136,9 @@ void DrawMessage(bool beforeMovie)
 			return;
 
 		uint8 *t;
-		guiMessage.howlong--;
+		//frames run ahead draw the message without using up its time
+		if(!FCEU_RunAheadSpeculating())
+			guiMessage.howlong--;
 
 		if (guiMessage.linesFromBottom > 0)
 			t=XBuf+FCEU_TextScanlineOffsetFromBottom(guiMessage.linesFromBottom)+1;
@@ -171,7 +175,8 @@ void DrawMessage(bool beforeMovie)
 			return;
 
 		uint8 *tt;
-		subtitleMessage.howlong--;
+		if(!FCEU_RunAheadSpeculating())
+			subtitleMessage.howlong--;
 		tt=XBuf+FCEU_TextScanlineOffsetFromBottom(216);
 
 		if(tt>=XBuf)
@@ -308,6 +313,7 @@ static void drawstatus(uint8* XBuf, int n, int y, int xofs)
 	int i;
 
 
+	FCEU_BeginOverlay();
 	XBuf += FCEU_TextScanlineOffsetFromBottom(y) + 240 + 255 + xofs;
 	for(i=0; slines[i]!=99; i+=3)
 	{
@@ -357,6 +363,7 @@ void FCEU_DrawNumberRow(uint8 *XBuf, int *nstatus, int cur)
 	uint8 *XBaf;
 	int z,x,y;
 
+	FCEU_BeginOverlay();
 	XBaf=XBuf - 4 + (FSettings.LastSLine-34)*256;
 	if(XBaf>=XBuf)
 		for(z=1;z<11;z++)
@@ -407,6 +414,7 @@ void DrawTextTransWH(uint8 *dest, int width, uint8 *textmsg, uint8 fgcolor, int
 	int beginx=2, x=beginx;
 	int y=2;
 
+	FCEU_BeginOverlay();
 	memset(target, 0, 64 * 256);
 
 	assert(width==256);
@@ -21,7 +21,7 @@ ArchiveScanRecord FCEUD_ScanArchive(std::string fname);
 const char *FCEUD_GetCompilerString();
 
 //This makes me feel dirty for some reason.
-void FCEU_printf(char *format, ...);
+void FCEU_printf(const char *format, ...);
 #define FCEUI_printf FCEU_printf
 
 //Video interface
@@ -138,6 +138,11 @@ void FCEUI_FrameSkip(int x);
 //First and last scanlines to render, for ntsc and pal emulation.
 void FCEUI_SetRenderedLines(int ntscf, int ntscl, int palf, int pall);
 
+//Lets the driver render straight from the PPU. The hook is called with each scanline as soon as
+//the PPU has finished it, and again after the overlays are drawn for every row they changed.
+//Pass NULL to go back to whole frames only. Not used by the new PPU.
+void FCEUI_SetLineHook(void (*hook)(int line, uint8 *row));
+
 //Sets the base directory(save states, snapshots, etc. are saved in directories below this directory.
 void FCEUI_SetBaseDirectory(std::string const & dir);
 
@@ -166,6 +171,23 @@ extern void FCEUI_SelectStateNext(int);
 void FCEUI_SaveState(const char *fname, bool display_message=true);
 void FCEUI_LoadState(const char *fname, bool display_message=true);
 
+//Like FCEUI_SaveState, but only the snapshot is taken on the calling thread.
+//The state is compressed and written on a background thread, to a temporary
+//file that is then renamed over the old one.
+void FCEUI_SaveStateAsync(const char *fname, bool display_message=true);
+//True while asynchronous saves are still being written
+bool FCEUI_SaveStatePending(void);
+//Blocks until every asynchronous save is on disk. Returns false if one failed.
+bool FCEUI_WaitStateSaves(void);
+
+//Size of the preview picture state files carry
+#define FCEU_THUMBNAIL_WIDTH 64
+#define FCEU_THUMBNAIL_HEIGHT 56
+//Reads only the preview picture of a state file into pixels, which must hold
+//FCEU_THUMBNAIL_WIDTH*FCEU_THUMBNAIL_HEIGHT RGB565 values. Returns false if
+//the file has none.
+bool FCEUI_LoadStateThumbnail(const char *fname, uint16 *pixels);
+
 void FCEUD_SaveStateAs(void);
 void FCEUD_LoadStateFrom(void);
 
@@ -183,7 +205,7 @@ void FCEUD_LuaRunFrom(void);
 int32 FCEUI_GetDesiredFPS(void);
 void FCEUI_SaveSnapshot(void);
 void FCEUI_SaveSnapshotAs(void);
-void FCEU_DispMessage(char *format, int disppos, ...);
+void FCEU_DispMessage(const char *format, int disppos, ...);
 #define FCEUI_DispMessage FCEU_DispMessage
 
 int FCEUI_DecodePAR(const char *code, int *a, int *v, int *c, int *type);
@@ -271,6 +293,23 @@ void FCEUD_OnCloseGame(void);
 void FCEUI_FrameAdvance(void);
 void FCEUI_FrameAdvanceEnd(void);
 
+//In-memory rewind. A snapshot is kept every <interval> frames while the snapshots
+//and the input log fit in <budget> bytes; an interval of 0 turns rewind off.
+void FCEUI_SetRewind(int interval, uint32 budget);
+//Makes the next FCEUI_Emulate() step one frame back instead of forward.
+void FCEUI_Rewind(void);
+
+//Run-ahead: every FCEUI_Emulate() shows the picture <frames> frames after the
+//real one, hiding that much input lag; 0 turns it off. <secondInstance> keeps
+//the look-ahead frames out of the sound mixer, for a little more work per frame.
+void FCEUI_SetRunAhead(int frames, bool secondInstance);
+
+//Movie state cache for FCEUMOV_SeekTo(). A state is cached every <interval>
+//frames of a movie while they fit in <budget> bytes; 0 turns the cache off.
+//The last <interval> frames played are also kept, uncompressed, outside the
+//budget, so short seeks back from the playhead replay only a frame or two.
+void FCEUI_SetMovieCache(int interval, uint32 budget);
+
 //AVI Output
 int FCEUI_AviBegin(const char* fname);
 void FCEUI_AviEnd(void);
@@ -3,11 +3,78 @@
 #include <stdio.h>
 #include <string.h>
 #include <stdlib.h>
+#include <time.h>
+#include <sys/stat.h>
 
 #include "../../types.h"
+#include "../../utils/asyncio.h"
 #include "configSys.h"
 
 std::string cfgFile = "fceux.cfg";
+
+// Every config file that is loaded or saved gets a binary snapshot of the
+// parsed values next to it, <file>.bin.  While the text file's mtime and size
+// still match the snapshot, loading it is one read instead of a parse.  The
+// snapshot also records the layout of the options (names, types, order), so
+// one written by a build with other options is ignored.  Snapshot format, in
+// native byte order:
+//   SNAPSHOTHEADER
+//   int    value of each integer option, in index order
+//   double value of each double option
+//   for each string option: uint32 length, then the characters
+#define SNAPSHOT_MAGIC      "FCEUCFG\x1a"
+#define SNAPSHOT_VERSION    1
+
+struct SNAPSHOTHEADER {
+    char magic[8];
+    uint32 version;
+    uint32 layout;
+    int64 mtime, size;      // of the text file
+    uint32 ints, dbls, strs;
+};
+
+static bool FileStamp(const std::string &name, int64 *mtime, int64 *size)
+{
+    struct stat st;
+    if(stat(name.c_str(), &st) != 0) {
+        return false;
+    }
+    *mtime = st.st_mtime;
+    *size = st.st_size;
+    return true;
+}
+
+/**
+ * Appends a value of the given type, set to 0 or "", for a new option.
+ * Returns the index of the value.
+ */
+int
+Config::_newOption(const std::string &name,
+                   int type)
+{
+    int idx = -1;
+    _layoutHash = 0;
+    switch(type) {
+    case(STRING):
+        idx = _strVals.size();
+        _strVals.push_back("");
+        _strOptMap[name] = idx;
+        break;
+    case(INTEGER):
+        idx = _intVals.size();
+        _intVals.push_back(0);
+        _intOptMap[name] = idx;
+        break;
+    case(DOUBLE):
+        idx = _dblVals.size();
+        _dblVals.push_back(0.0);
+        _dblOptMap[name] = idx;
+        break;
+    default:
+        break;
+    }
+    return idx;
+}
 /**
  * Add a given option.  The option is specified as a short command
  * line (-f), long command line (--foo), option name (Foo), its type
@@ -35,21 +102,10 @@ Config::_addOption(char shortArg,
     }
 
     // add the option
-    switch(type) {
-    case(STRING):
-        _strOptMap[name] = "";
-        break;
-    case(INTEGER):
-        _intOptMap[name] = 0;
-        break;
-    case(DOUBLE):
-        _dblOptMap[name] = 0.0;
-        break;
-    case(FUNCTION):
+    if(type == FUNCTION) {
         _fnOptMap[name] = NULL;
-        break;
-    default:
-        break;
+    } else {
+        _newOption(name, type);
     }
     _shortArgMap[shortArg] = name;
     _longArgMap[longArg] = name;
@@ -76,19 +132,7 @@ Config::_addOption(const std::string &longArg,
     }
 
     // add the option
-    switch(type) {
-    case(STRING):
-        _strOptMap[name] = "";
-        break;
-    case(INTEGER):
-        _intOptMap[name] = 0;
-        break;
-    case(DOUBLE):
-        _dblOptMap[name] = 0.0;
-        break;
-    default:
-        break;
-    }
+    _newOption(name, type);
     _longArgMap[longArg] = name;
 
     return 0;
@@ -281,7 +325,7 @@ Config::addOption(const std::string &name,
     }
 
     // add the option
-    _strOptMap[name] = defaultValue;
+    _strVals[_newOption(name, STRING)] = defaultValue;
     return 0;
 }
 
@@ -294,7 +338,7 @@ Config::addOption(const std::string &name,
     }
 
     // add the option
-    _intOptMap[name] = defaultValue;
+    _intVals[_newOption(name, INTEGER)] = defaultValue;
     return 0;
 }
 
@@ -307,7 +351,7 @@ Config::addOption(const std::string &name,
     }
 
     // add the option
-    _dblOptMap[name] = defaultValue;
+    _dblVals[_newOption(name, DOUBLE)] = defaultValue;
     return 0;
 }
 
@@ -327,7 +371,7 @@ Config::setOption(const std::string &name,
     }
 
     // set the option
-    opt_i->second = value;
+    _intVals[opt_i->second] = value;
     return 0;
 }
 
@@ -338,7 +382,7 @@ int
 Config::setOption(const std::string &name,
                   double value)
 {
-    std::map<std::string, double>::iterator opt_i;
+    std::map<std::string, int>::iterator opt_i;
 
     // confirm that the option exists
     opt_i = _dblOptMap.find(name);
@@ -347,7 +391,7 @@ Config::setOption(const std::string &name,
     }
 
     // set the option
-    opt_i->second = value;
+    _dblVals[opt_i->second] = value;
     return 0;
 }
 
@@ -358,7 +402,7 @@ int
 Config::setOption(const std::string &name,
                   const std::string &value)
 {
-    std::map<std::string, std::string>::iterator opt_i;
+    std::map<std::string, int>::iterator opt_i;
 
     // confirm that the option exists
     opt_i = _strOptMap.find(name);
@@ -367,7 +411,7 @@ Config::setOption(const std::string &name,
     }
 
     // set the option
-    opt_i->second = value;
+    _strVals[opt_i->second] = value;
     return 0;
 }
 
@@ -396,7 +440,7 @@ int
 Config::getOption(const std::string &name,
                   std::string *value)
 {
-    std::map<std::string, std::string>::iterator opt_i;
+    std::map<std::string, int>::iterator opt_i;
 
     // confirm that the option exists
     opt_i = _strOptMap.find(name);
@@ -405,7 +449,7 @@ Config::getOption(const std::string &name,
     }
 
     // get the option
-    (*value) = opt_i->second;
+    (*value) = _strVals[opt_i->second];
     return 0;
 }
 
@@ -413,7 +457,7 @@ int
 Config::getOption(const std::string &name,
                   const char **value)
 {
-    std::map<std::string, std::string>::iterator opt_i;
+    std::map<std::string, int>::iterator opt_i;
 
     // confirm that the option exists
     opt_i = _strOptMap.find(name);
@@ -422,7 +466,7 @@ Config::getOption(const std::string &name,
     }
 
     // get the option
-    (*value) = opt_i->second.c_str();
+    (*value) = _strVals[opt_i->second].c_str();
     return 0;
 }
 
@@ -439,7 +483,7 @@ Config::getOption(const std::string &name,
     }
 
     // get the option
-    (*value) = opt_i->second;
+    (*value) = _intVals[opt_i->second];
     return 0;
 }
 
@@ -447,7 +491,7 @@ int
 Config::getOption(const std::string &name,
                   double *value)
 {
-    std::map<std::string, double>::iterator opt_i;
+    std::map<std::string, int>::iterator opt_i;
 
     // confirm that the option exists
     opt_i = _dblOptMap.find(name);
@@ -456,7 +500,120 @@ Config::getOption(const std::string &name,
     }
 
     // get the option
-    (*value) = opt_i->second;
+    (*value) = _dblVals[opt_i->second];
+    return 0;
+}
+
+/**
+ * Resolves the handle of an integer option.
+ */
+int
+Config::findOption(const std::string &name,
+                   IntOption *handle)
+{
+    std::map<std::string, int>::iterator opt_i = _intOptMap.find(name);
+    handle->idx = (opt_i == _intOptMap.end()) ? -1 : opt_i->second;
+    return (handle->idx < 0) ? -1 : 0;
+}
+
+/**
+ * Resolves the handle of a double option.
+ */
+int
+Config::findOption(const std::string &name,
+                   DoubleOption *handle)
+{
+    std::map<std::string, int>::iterator opt_i = _dblOptMap.find(name);
+    handle->idx = (opt_i == _dblOptMap.end()) ? -1 : opt_i->second;
+    return (handle->idx < 0) ? -1 : 0;
+}
+
+/**
+ * Resolves the handle of a string option.
+ */
+int
+Config::findOption(const std::string &name,
+                   StringOption *handle)
+{
+    std::map<std::string, int>::iterator opt_i = _strOptMap.find(name);
+    handle->idx = (opt_i == _strOptMap.end()) ? -1 : opt_i->second;
+    return (handle->idx < 0) ? -1 : 0;
+}
+
+int
+Config::getOption(IntOption handle,
+                  int *value)
+{
+    if(handle.idx < 0) {
+        return -1;
+    }
+    (*value) = _intVals[handle.idx];
+    return 0;
+}
+
+int
+Config::getOption(DoubleOption handle,
+                  double *value)
+{
+    if(handle.idx < 0) {
+        return -1;
+    }
+    (*value) = _dblVals[handle.idx];
+    return 0;
+}
+
+int
+Config::getOption(StringOption handle,
+                  std::string *value)
+{
+    if(handle.idx < 0) {
+        return -1;
+    }
+    (*value) = _strVals[handle.idx];
+    return 0;
+}
+
+int
+Config::getOption(StringOption handle,
+                  const char **value)
+{
+    if(handle.idx < 0) {
+        return -1;
+    }
+    (*value) = _strVals[handle.idx].c_str();
+    return 0;
+}
+
+int
+Config::setOption(IntOption handle,
+                  int value)
+{
+    if(handle.idx < 0) {
+        return -1;
+    }
+    _intVals[handle.idx] = value;
+    return 0;
+}
+
+int
+Config::setOption(DoubleOption handle,
+                  double value)
+{
+    if(handle.idx < 0) {
+        return -1;
+    }
+    _dblVals[handle.idx] = value;
+    return 0;
+}
+
+int
+Config::setOption(StringOption handle,
+                  const std::string &value)
+{
+    if(handle.idx < 0) {
+        return -1;
+    }
+    _strVals[handle.idx] = value;
     return 0;
 }
 
@@ -470,10 +627,9 @@ Config::_parseArgs(int argc,
                    char **argv)
 {
     int retval = 0;
-    std::map<std::string, std::string>::iterator long_i, str_i;
+    std::map<std::string, std::string>::iterator long_i;
     std::map<char, std::string>::iterator short_i;
-    std::map<std::string, int>::iterator int_i;
-    std::map<std::string, double>::iterator dbl_i;
+    std::map<std::string, int>::iterator str_i, int_i, dbl_i;
     std::map<std::string, void (*)(const std::string &)>::iterator fn_i;
     std::string arg, opt, value;
 
@@ -524,11 +680,11 @@ Config::_parseArgs(int argc,
         dbl_i = _dblOptMap.find(opt);
         fn_i  = _fnOptMap.find(opt);
         if(str_i != _strOptMap.end()) {
-            str_i->second = argv[i];
+            _strVals[str_i->second] = argv[i];
         } else if(int_i != _intOptMap.end()) {
-            int_i->second = atol(argv[i]);
+            _intVals[int_i->second] = atol(argv[i]);
         } else if(dbl_i != _dblOptMap.end()) {
-            dbl_i->second = atof(argv[i]);
+            _dblVals[dbl_i->second] = atof(argv[i]);
         } else if(fn_i != _fnOptMap.end()) {
             (*(fn_i->second))(argv[i]);
         } else {
@@ -567,14 +723,6 @@ Config::parse(int argc,
 }
 
 
-/**
- * Read each line of the config file and put the variables into the
- * config maps.  Valid configuration lines are of the form:
- *
- * <option name> = <option value>
- *
- * Lines beginning with # are ignored.
- */
 char* Config::getConfigDirectory()
 {
 	return strdup(_dir.c_str());
@@ -583,79 +731,53 @@ char* Config::getConfigDirectory()
 int 
 Config::reload(const std::string &cfgname)
 {
-   signed int pos, eqPos;
-    std::fstream config;
-    std::map<std::string, int>::iterator int_i;
-    std::map<std::string, double>::iterator dbl_i;
-    std::map<std::string, std::string>::iterator str_i;
-    std::string line, name, value;
-    char buf[1024];
-
-    // set the exception handling to catch i/o errors
-    config.exceptions(std::fstream::badbit);
-
-    try {
-        // open the file for reading (create if it doesn't exist)
-        config.open(cfgname.c_str(), std::ios::in | std::ios::out);
-        if(!config.is_open()) {
-            // XXX file couldn't be opened?
-            return _load();
-        }
-
-        while(!config.eof()) {
-            // read a line
-            config.getline(buf, 1024);
-            line = buf;
-
-            // check line validity
-            eqPos = line.find("=");
-            if(line[0] == '#') {
-                // skip this line
-                continue;
-            }
-
-            // get the name and value for the option
-            pos = line.find(" ");
-            name = line.substr(0, (pos > eqPos) ? eqPos : pos);
-            pos = line.find_first_not_of(" ", eqPos + 1);
-	    if (pos == std::string::npos) value = "";
-	    else value = line.substr(pos);
-
-            // check if the option exists, and if so, set it appropriately
-            str_i = _strOptMap.find(name);
-            dbl_i = _dblOptMap.find(name);
-            int_i = _intOptMap.find(name);
-            if(str_i != _strOptMap.end()) {
-                str_i->second = value;
-            } else if(int_i != _intOptMap.end()) {
-                int_i->second = atol(value.c_str());
-            } else if(dbl_i != _dblOptMap.end()) {
-                dbl_i->second = atof(value.c_str());
-            }
-        }
-
-        // close the file
-        config.close();
-    } catch(std::fstream::failure e) {
-        std::cerr << e.what() << std::endl;
-        return -1;
+    bool opened;
+    int error = _loadFile(cfgname, &opened);
+    if(!opened) {
+        // XXX file couldn't be opened?
+        return _load();
     }
-
-    return 0;
+    return error;
 }
 
 int
 Config::_load()
+{
+    bool opened;
+    return _loadFile(_dir + "/" + cfgFile, &opened);
+}
+
+/**
+ * Read each line of the config file and put the variables into the
+ * config maps.  Valid configuration lines are of the form:
+ *
+ * <option name> = <option value>
+ *
+ * Lines beginning with # are ignored.  The snapshot is read instead
+ * while it is current, and written after parsing a file that set every
+ * option.
+ */
+int
+Config::_loadFile(const std::string &configFile,
+                  bool *opened)
 {
     signed int pos, eqPos;
     std::fstream config;
     std::map<std::string, int>::iterator int_i;
-    std::map<std::string, double>::iterator dbl_i;
-    std::map<std::string, std::string>::iterator str_i;
-    std::string configFile = _dir + "/" + cfgFile;
+    std::map<std::string, int>::iterator dbl_i;
+    std::map<std::string, int>::iterator str_i;
     std::string line, name, value;
     char buf[1024];
 
+    *opened = true;
+    if(_loadSnapshot(configFile)) {
+        return 0;
+    }
+
+    // which options the file set
+    std::vector<bool> intSet(_intVals.size()), dblSet(_dblVals.size()), strSet(_strVals.size());
+    size_t set = 0;
+
     // set the exception handling to catch i/o errors
     config.exceptions(std::fstream::badbit);
 
@@ -663,7 +785,7 @@ Config::_load()
         // open the file for reading (create if it doesn't exist)
         config.open(configFile.c_str(), std::ios::in | std::ios::out);
         if(!config.is_open()) {
-            // XXX file couldn't be opened?
+            *opened = false;
             return 0;
         }
 
@@ -691,11 +813,23 @@ Config::_load()
             dbl_i = _dblOptMap.find(name);
             int_i = _intOptMap.find(name);
             if(str_i != _strOptMap.end()) {
-                str_i->second = value;
+                _strVals[str_i->second] = value;
+                if(!strSet[str_i->second]) {
+                    strSet[str_i->second] = true;
+                    set++;
+                }
             } else if(int_i != _intOptMap.end()) {
-                int_i->second = atol(value.c_str());
+                _intVals[int_i->second] = atol(value.c_str());
+                if(!intSet[int_i->second]) {
+                    intSet[int_i->second] = true;
+                    set++;
+                }
             } else if(dbl_i != _dblOptMap.end()) {
-                dbl_i->second = atof(value.c_str());
+                _dblVals[dbl_i->second] = atof(value.c_str());
+                if(!dblSet[dbl_i->second]) {
+                    dblSet[dbl_i->second] = true;
+                    set++;
+                }
             }
         }
 
@@ -706,67 +840,181 @@ Config::_load()
         return -1;
     }
 
+    // the values only stand for the file alone if it set all of them, and
+    // a change later in the same second wouldn't move the mtime
+    int64 mtime, size;
+    if(set == _intVals.size() + _dblVals.size() + _strVals.size() &&
+       FileStamp(configFile, &mtime, &size) && time(NULL) > mtime + 1) {
+        _saveSnapshot(configFile);
+    }
+
     return 0;
 }
 
 /**
- * Writes the configuration file with the current configuration settings.
+ * Hashes the names, types and indices of the options, FNV-1a.  Kept
+ * until another option is added.
  */
-int
-Config::save()
+unsigned int
+Config::_layout()
 {
-    std::fstream config;
-    std::map<std::string, int>::iterator int_i;
-    std::map<std::string, double>::iterator dbl_i;
-    std::map<std::string, std::string>::iterator str_i;
-    std::string configFile = _dir + "/" + cfgFile;
-    char buf[1024];
-
-    // set the exception handling to catch i/o errors
-    config.exceptions(std::ios::failbit | std::ios::badbit);
+    if(_layoutHash) {
+        return _layoutHash;
+    }
 
-    try {
-        // open the file, truncate and for write
-        config.open(configFile.c_str(), std::ios::out | std::ios::trunc);
+    const std::map<std::string, int> *maps[3] = { &_intOptMap, &_dblOptMap, &_strOptMap };
+    unsigned int hash = 2166136261u;
+
+    for(int m = 0; m < 3; m++) {
+        std::map<std::string, int>::const_iterator opt_i;
+        for(opt_i = maps[m]->begin(); opt_i != maps[m]->end(); opt_i++) {
+            const char *p = opt_i->first.c_str();
+            do {
+                hash = (hash ^ (unsigned char)*p) * 16777619u;
+            } while(*p++);
+            for(int b = 0; b < 32; b += 8) {
+                hash = (hash ^ ((opt_i->second >> b) & 0xFF)) * 16777619u;
+            }
+        }
+        hash = (hash ^ ('0' + m)) * 16777619u;
+    }
+    _layoutHash = hash ? hash : 1;
+    return _layoutHash;
+}
 
-        // write a warning
-        strcpy(buf, "# Auto-generated\n");
-        config.write(buf, strlen(buf));
+/**
+ * Sets every option from the snapshot of the given config file.  Returns
+ * false, changing nothing, unless the snapshot is current and complete.
+ */
+bool
+Config::_loadSnapshot(const std::string &configFile)
+{
+    int64 mtime, size;
+    if(!FileStamp(configFile, &mtime, &size)) {
+        return false;
+    }
 
-        // write each configuration setting
-        for(int_i = _intOptMap.begin(); int_i != _intOptMap.end(); int_i++) {
-            snprintf(buf, 1024, "%s = %d\n",
-                     int_i->first.c_str(), int_i->second);
-            config.write(buf, strlen(buf));
+    FILE *fp = fopen((configFile + ".bin").c_str(), "rb");
+    if(!fp) {
+        return false;
+    }
+    std::vector<char> data;
+    long len = -1;
+    if(!fseek(fp, 0, SEEK_END) && (len = ftell(fp)) >= (long)sizeof(SNAPSHOTHEADER) &&
+       !fseek(fp, 0, SEEK_SET)) {
+        data.resize(len);
+        if(fread(&data[0], 1, len, fp) != (size_t)len) {
+            len = -1;
         }
-        for(dbl_i = _dblOptMap.begin(); dbl_i != _dblOptMap.end(); dbl_i++) {
-            snprintf(buf, 1024, "%s = %f\n",
-                     dbl_i->first.c_str(), dbl_i->second);
-            config.write(buf, strlen(buf));
+    }
+    fclose(fp);
+    if(len < (long)sizeof(SNAPSHOTHEADER)) {
+        return false;
+    }
+
+    SNAPSHOTHEADER h;
+    memcpy(&h, &data[0], sizeof(h));
+    if(memcmp(h.magic, SNAPSHOT_MAGIC, 8) || h.version != SNAPSHOT_VERSION ||
+       h.mtime != mtime || h.size != size ||
+       h.ints != _intVals.size() || h.dbls != _dblVals.size() ||
+       h.strs != _strVals.size() || h.layout != _layout()) {
+        return false;
+    }
+
+    size_t pos = sizeof(h);
+    size_t numbers = h.ints * sizeof(int) + h.dbls * sizeof(double);
+    if(numbers > data.size() - pos) {
+        return false;
+    }
+    std::vector<std::string> strs(h.strs);
+    size_t spos = pos + numbers;
+    for(uint32 i = 0; i < h.strs; i++) {
+        uint32 slen;
+        if(data.size() - spos < sizeof(slen)) {
+            return false;
         }
-        for(str_i = _strOptMap.begin(); str_i != _strOptMap.end(); str_i++) {
-            snprintf(buf, 1024, "%s = %s\n",
-                     str_i->first.c_str(), str_i->second.c_str());
-            config.write(buf, strlen(buf));
+        memcpy(&slen, &data[spos], sizeof(slen));
+        spos += sizeof(slen);
+        if(data.size() - spos < slen) {
+            return false;
         }
+        strs[i].assign(&data[spos], slen);
+        spos += slen;
+    }
 
-        // close the file
-        config.close();
-    } catch(std::fstream::failure e) {
-        std::cerr << e.what() << std::endl;
-        return -1;
+    if(h.ints) {
+        memcpy(&_intVals[0], &data[pos], h.ints * sizeof(int));
+    }
+    pos += h.ints * sizeof(int);
+    if(h.dbls) {
+        memcpy(&_dblVals[0], &data[pos], h.dbls * sizeof(double));
     }
+    for(uint32 i = 0; i < h.strs; i++) {
+        _strVals[i].swap(strs[i]);
+    }
+    return true;
+}
 
-    return 0;
+/**
+ * Writes the snapshot of the given config file, which must hold the
+ * current values of all options.
+ */
+void
+Config::_saveSnapshot(const std::string &configFile)
+{
+    SNAPSHOTHEADER h;
+    memset(&h, 0, sizeof(h));
+    if(!FileStamp(configFile, &h.mtime, &h.size)) {
+        return;
+    }
+    memcpy(h.magic, SNAPSHOT_MAGIC, 8);
+    h.version = SNAPSHOT_VERSION;
+    h.layout = _layout();
+    h.ints = _intVals.size();
+    h.dbls = _dblVals.size();
+    h.strs = _strVals.size();
+
+    std::string data((const char *)&h, sizeof(h));
+    if(h.ints) {
+        data.append((const char *)&_intVals[0], h.ints * sizeof(int));
+    }
+    if(h.dbls) {
+        data.append((const char *)&_dblVals[0], h.dbls * sizeof(double));
+    }
+    for(uint32 i = 0; i < h.strs; i++) {
+        uint32 slen = _strVals[i].size();
+        data.append((const char *)&slen, sizeof(slen));
+        data.append(_strVals[i]);
+    }
+
+    FCEU_WriteFileAtomic((configFile + ".bin").c_str(), data.data(), data.size());
+}
+
+/**
+ * Writes the configuration file with the current configuration settings.
+ */
+int
+Config::save()
+{
+    return _saveFile(_dir + "/" + cfgFile);
 }
 
 int
 Config::save(const std::string &name)
+{
+    return _saveFile(name);
+}
+
+/**
+ * Writes the given configuration file and its snapshot.
+ */
+int
+Config::_saveFile(const std::string &configFile)
 {
     std::fstream config;
     std::map<std::string, int>::iterator int_i;
-    std::map<std::string, double>::iterator dbl_i;
-    std::map<std::string, std::string>::iterator str_i;
+    std::map<std::string, int>::iterator dbl_i;
+    std::map<std::string, int>::iterator str_i;
     char buf[1024];
 
     // set the exception handling to catch i/o errors
@@ -774,7 +1022,7 @@ Config::save(const std::string &name)
 
     try {
         // open the file, truncate and for write
-        config.open(name.c_str(), std::ios::out | std::ios::trunc);
+        config.open(configFile.c_str(), std::ios::out | std::ios::trunc);
 
         // write a warning
         strcpy(buf, "# Auto-generated\n");
@@ -783,17 +1031,17 @@ Config::save(const std::string &name)
         // write each configuration setting
         for(int_i = _intOptMap.begin(); int_i != _intOptMap.end(); int_i++) {
             snprintf(buf, 1024, "%s = %d\n",
-                     int_i->first.c_str(), int_i->second);
+                     int_i->first.c_str(), _intVals[int_i->second]);
             config.write(buf, strlen(buf));
         }
         for(dbl_i = _dblOptMap.begin(); dbl_i != _dblOptMap.end(); dbl_i++) {
             snprintf(buf, 1024, "%s = %f\n",
-                     dbl_i->first.c_str(), dbl_i->second);
+                     dbl_i->first.c_str(), _dblVals[dbl_i->second]);
             config.write(buf, strlen(buf));
         }
         for(str_i = _strOptMap.begin(); str_i != _strOptMap.end(); str_i++) {
             snprintf(buf, 1024, "%s = %s\n",
-                     str_i->first.c_str(), str_i->second.c_str());
+                     str_i->first.c_str(), _strVals[str_i->second].c_str());
             config.write(buf, strlen(buf));
         }
 
@@ -804,5 +1052,7 @@ Config::save(const std::string &name)
         return -1;
     }
 
+    // the text just written holds every option, the snapshot can say the same
+    _saveSnapshot(configFile);
     return 0;
 }
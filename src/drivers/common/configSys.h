@@ -1,25 +1,55 @@
 #ifndef __CONFIGSYS_H
 #define __CONFIGSYS_H
 
+#include <deque>
 #include <map>
 #include <string>
+#include <vector>
 
 class Config {
+public:
+    /**
+     * A typed handle to an option: the index of its value in the flat
+     * array for its type.  Resolve it once with findOption(); getting
+     * and setting through it skips the lookup by name.
+     */
+    template<typename T> struct Handle {
+        int idx;
+        Handle() : idx(-1) { }
+    };
+    typedef Handle<int>         IntOption;
+    typedef Handle<double>      DoubleOption;
+    typedef Handle<std::string> StringOption;
+
 private:
     std::string _dir;
 
-    std::map<std::string, std::string>    _strOptMap;
+    // option name -> index into the value array of its type
+    std::map<std::string, int>            _strOptMap;
     std::map<std::string, int>            _intOptMap;
-    std::map<std::string, double>         _dblOptMap;
+    std::map<std::string, int>            _dblOptMap;
     std::map<std::string, void (*)(const std::string &)> _fnOptMap;
 
+    // a deque, so the c_str() handed out by getOption stays put
+    std::deque<std::string> _strVals;
+    std::vector<int>        _intVals;
+    std::vector<double>     _dblVals;
+
     std::map<char, std::string>        _shortArgMap;
     std::map<std::string, std::string> _longArgMap;
 
+    unsigned int _layoutHash;   // of the options, 0 until needed again
+
 private:
     int _addOption(char, const std::string &, const std::string &, int);
     int _addOption(const std::string &, const std::string &, int);
+    int _newOption(const std::string &, int);
     int _load(void);
+    int _loadFile(const std::string &, bool *);
+    int _saveFile(const std::string &);
+    unsigned int _layout(void);
+    bool _loadSnapshot(const std::string &);
+    void _saveSnapshot(const std::string &);
     int _parseArgs(int, char **);
 
 public:
@@ -29,7 +59,7 @@ public:
     const static int FUNCTION = 4;
 
 public:
-    Config(std::string d) : _dir(d) { }
+    Config(std::string d) : _dir(d), _layoutHash(0) { }
     ~Config() { }
 
     /**
@@ -75,9 +105,29 @@ public:
     int getOption(const std::string &, int *);
     int getOption(const std::string &, double *);
 
+    /**
+     * Resolves the handle of an option.  Returns -1, leaving the handle
+     * invalid, if there is no such option of that type.
+     */
+    int findOption(const std::string &, IntOption *);
+    int findOption(const std::string &, DoubleOption *);
+    int findOption(const std::string &, StringOption *);
+
+    /**
+     * Gets and sets an option through its handle.
+     */
+    int getOption(IntOption, int *);
+    int getOption(DoubleOption, double *);
+    int getOption(StringOption, std::string *);
+    int getOption(StringOption, const char **);
+    int setOption(IntOption, int);
+    int setOption(DoubleOption, double);
+    int setOption(StringOption, const std::string &);
+
     /**
      * read in the configuration file and
-     * set the variables accordingly.
+     * set the variables accordingly.  The binary snapshot saved
+     * next to it, <file>.bin, is read instead while it is current.
      */
     int load();
 
@@ -96,7 +146,7 @@ public:
 
     /**
      * Save all of the current configuration options to the
-     * configuration file.
+     * configuration file, and its binary snapshot.
      */
     int save();
     
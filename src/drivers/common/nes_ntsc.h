@@ -108,7 +108,12 @@ statement in a block (unless you're using C++). */
 
 /* private */
 enum { nes_ntsc_entry_size = 128 };
+/* at least 32 bits; NES_NTSC_RGB_T can pick the type */
+#ifdef NES_NTSC_RGB_T
+typedef NES_NTSC_RGB_T nes_ntsc_rgb_t;
+#else
 typedef unsigned long nes_ntsc_rgb_t;
+#endif
 struct nes_ntsc_t {
 	nes_ntsc_rgb_t table [nes_ntsc_palette_size] [nes_ntsc_entry_size];
 };
@@ -31,7 +31,6 @@
 #include "nes_ntsc.h"
 
 extern u8 *XBuf;
-extern u8 *XBackBuf;
 extern u8 *XDBuf;
 extern u8 *XDBackBuf;
 extern pal *palo;
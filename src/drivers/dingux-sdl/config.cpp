@@ -105,6 +105,8 @@ static void GetBaseDirectory(std::string &dir)
 #endif
 }
 
+DRIVEROPTIONS g_opts;
+
 Config * InitConfig() {
 	std::string dir, prefix;
 	Config *config;
@@ -160,6 +162,10 @@ Config * InitConfig() {
 	config->addOption("ystretch", "SDL.YStretch", 0);
 	config->addOption("noframe", "SDL.NoFrame", 0);
 	config->addOption("special", "SDL.SpecialFilter", 0);
+	config->addOption("blitbench", "SDL.BlitBench", 0);
+	config->addOption("directrender", "SDL.DirectRender", 0);
+	config->addOption("videobackend", "SDL.VideoBackend", "sdl");
+	config->addOption("videodevice", "SDL.VideoDevice", "");
 
 	// NOT SUPPORTED
 	// OpenGL options
@@ -232,9 +238,37 @@ Config * InitConfig() {
 	config->addOption("loadStateFile", "SDL.loadStateFile", "");
 	config->setOption("SDL.loadStateFile", "");
 
+	// Instant Play resume image, tried before loadStateFile
+	config->addOption("resumeFile", "SDL.ResumeFile", "");
+	config->setOption("SDL.ResumeFile", "");
+
 	// enable new PPU core
 	config->addOption("newppu", "SDL.NewPPU", 0);
 
+	// back buffer in savestates: 0 omit, 1 raw, 2 compressed
+	config->addOption("statebackbuf", "SDL.StateBackBuffer", 1);
+
+	// savestate compression: 0 zlib, 1 fast LZ
+	config->addOption("statecodec", "SDL.StateCodec", 1);
+
+	// preview picture in savestate files, for the save/load menu
+	config->addOption("statethumb", "SDL.StateThumbnail", 1);
+
+	// rewind: snapshot interval in frames (0 off), memory budget in MB
+	config->addOption("rewind", "SDL.Rewind", 10);
+	config->addOption("rewindbuf", "SDL.RewindBuffer", 16);
+
+	// run-ahead: frames to look ahead (0 off), keep the sound mixer out of it
+	config->addOption("runahead", "SDL.RunAhead", 0);
+	config->addOption("runaheadsecond", "SDL.RunAheadSecondInstance", 0);
+
+	// movie state cache for seeking: interval in frames (0 off), memory budget in MB
+	config->addOption("moviecache", "SDL.MovieCache", 30);
+	config->addOption("moviecachebuf", "SDL.MovieCacheBuffer", 8);
+
+	// print the startup timeline once the first frame is out
+	config->addOption("tracestartup", "SDL.StartupTrace", 0);
+
 	// GamePad 0 - 3
 	for (unsigned int i = 0; i < GAMEPAD_NUM_DEVICES; i++) {
 		char buf[64];
@@ -398,6 +432,31 @@ Config * InitConfig() {
 	config->addOption("SDL.Zapper.0.DeviceType", "Mouse");
 	config->addOption("SDL.Zapper.0.DeviceNum", 0);
 
+	config->findOption("SDL.Sound", &g_opts.sound);
+	config->findOption("SDL.Sound.Rate", &g_opts.soundRate);
+	config->findOption("SDL.Sound.BufSize", &g_opts.soundBufSize);
+	config->findOption("SDL.Sound.Volume", &g_opts.soundVolume);
+	config->findOption("SDL.Sound.Quality", &g_opts.soundQuality);
+	config->findOption("SDL.Sound.TriangleVolume", &g_opts.soundTriangleVolume);
+	config->findOption("SDL.Sound.Square1Volume", &g_opts.soundSquare1Volume);
+	config->findOption("SDL.Sound.Square2Volume", &g_opts.soundSquare2Volume);
+	config->findOption("SDL.Sound.NoiseVolume", &g_opts.soundNoiseVolume);
+	config->findOption("SDL.Sound.PCMVolume", &g_opts.soundPCMVolume);
+	config->findOption("SDL.Sound.LowPass", &g_opts.soundLowPass);
+	config->findOption("SDL.Sound.RecordFile", &g_opts.soundRecordFile);
+	config->findOption("SDL.PAL", &g_opts.pal);
+	config->findOption("SDL.Frameskip", &g_opts.frameskip);
+	config->findOption("SDL.MouseSpeed", &g_opts.mouseSpeed);
+	config->findOption("SDL.ShowMouseCursor", &g_opts.showMouseCursor);
+	config->findOption("SDL.ShowFPS", &g_opts.showFPS);
+	config->findOption("SDL.FPSThrottle", &g_opts.fpsThrottle);
+	config->findOption("SDL.Fullscreen", &g_opts.fullscreen);
+	config->findOption("SDL.ClipSides", &g_opts.clipSides);
+	config->findOption("SDL.BlitBench", &g_opts.blitBench);
+	config->findOption("SDL.DirectRender", &g_opts.directRender);
+	config->findOption("SDL.VideoBackend", &g_opts.videoBackend);
+	config->findOption("SDL.VideoDevice", &g_opts.videoDevice);
+
 	return config;
 }
 
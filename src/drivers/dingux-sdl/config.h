@@ -4,6 +4,20 @@
 #include "../common/configSys.h"
 
 Config *InitConfig(void);
+
+// Handles to the options read on every game load and driver reset,
+// resolved once by InitConfig
+struct DRIVEROPTIONS {
+	Config::IntOption sound, soundRate, soundBufSize, soundVolume, soundQuality,
+		soundTriangleVolume, soundSquare1Volume, soundSquare2Volume,
+		soundNoiseVolume, soundPCMVolume, soundLowPass;
+	Config::StringOption soundRecordFile;
+	Config::IntOption pal, frameskip, mouseSpeed, showMouseCursor, showFPS,
+		fpsThrottle;
+	Config::IntOption fullscreen, clipSides, blitBench, directRender;
+	Config::StringOption videoBackend, videoDevice;
+};
+extern DRIVEROPTIONS g_opts;
 void UpdateEMUCore(Config *);
 int LoadCPalette(const std::string &file);
 
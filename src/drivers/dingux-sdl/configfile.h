@@ -8,6 +8,7 @@
 #define ASPECT_RATIOS \
     X(ASPECT_RATIOS_TYPE_STRETCHED, "STRETCHED") \
     X(ASPECT_RATIOS_TYPE_CROPPED, "CROPPED") \
+    X(ASPECT_RATIOS_TYPE_NTSC, "NTSC") \
     X(NB_ASPECT_RATIOS_TYPES, "")
 
 ////------ Enumeration of the different aspect ratios ------
@@ -0,0 +1,685 @@
+/* FCE Ultra - NES/Famicom Emulator
+ *
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation; either version 2 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307  USA
+ */
+
+/// \file
+/// \brief Hardware scaled video output for the dingux driver.
+///
+/// Instead of scaling into hw_screen in software, the native 256x240 frame
+/// is written into one of two page flipped buffers and the display hardware
+/// does the scaling: the fbdev panel controller (the mode is set to 256x240)
+/// or a KMS overlay plane. Without a scaler the frame is shown 1:1 in the
+/// middle of the screen. This is what DRM's virtual device shows, so the
+/// KMS path can be tried on a desktop without special hardware:
+///
+///   modprobe vkms
+///   fceux --videobackend kms --videodevice /dev/dri/card1 game.nes
+
+#include <stdio.h>
+#include <string.h>
+#include <stdlib.h>
+#include <stdint.h>
+#include <errno.h>
+#include <fcntl.h>
+#include <unistd.h>
+#include <poll.h>
+#include <sys/ioctl.h>
+#include <sys/mman.h>
+#include <linux/fb.h>
+#include <drm/drm.h>
+#include <drm/drm_mode.h>
+
+#include "dingoo-hwout.h"
+
+#ifndef FBIO_WAITFORVSYNC
+#define FBIO_WAITFORVSYNC _IOW('F', 0x20, __u32)
+#endif
+
+#ifndef DRM_MODE_TYPE_PREFERRED
+#define DRM_MODE_TYPE_PREFERRED (1<<3)
+#endif
+
+static int s_backend = HWOUT_NONE;
+static int s_fd = -1;
+static bool s_suspended = false;
+
+/* 256x240 frame inside each of the two buffers */
+static uint16 *s_frame[2];
+static int s_pitch;		// in pixels
+static int s_back;		// buffer the next frame is drawn into
+
+static void ClearFrames(void) {
+	for (int i = 0; i < 2; i++)
+		for (int y = 0; y < HWOUT_HEIGHT; y++)
+			memset(s_frame[i] + y * s_pitch, 0, HWOUT_WIDTH * sizeof(uint16));
+}
+
+/* ------------------------------------------------------------------------ */
+/* fbdev                                                                    */
+/* ------------------------------------------------------------------------ */
+
+static struct fb_var_screeninfo s_fb_orig;
+static struct fb_var_screeninfo s_fb_var;
+static uint8 *s_fb_mem = NULL;
+static size_t s_fb_len = 0;
+static bool s_fb_double;
+
+/**
+ * Asks for a 256x240 RGB565 mode with room for two pages. If the panel
+ * controller can't scale, the current resolution is kept and the frame is
+ * centered in it. Returns 0 on success, -1 on failure.
+ */
+static int FBDevSetMode(void) {
+	struct fb_var_screeninfo var = s_fb_orig;
+
+	var.xres = var.xres_virtual = HWOUT_WIDTH;
+	var.yres = HWOUT_HEIGHT;
+	var.yres_virtual = HWOUT_HEIGHT * 2;
+	var.xoffset = var.yoffset = 0;
+	var.bits_per_pixel = 16;
+	var.activate = FB_ACTIVATE_NOW;
+
+	if (ioctl(s_fd, FBIOPUT_VSCREENINFO, &var) < 0 || var.xres != HWOUT_WIDTH || var.yres != HWOUT_HEIGHT) {
+		/* no scaler, keep the resolution */
+		var = s_fb_orig;
+		var.yres_virtual = var.yres * 2;
+		var.xoffset = var.yoffset = 0;
+		var.bits_per_pixel = 16;
+		var.activate = FB_ACTIVATE_NOW;
+		if (ioctl(s_fd, FBIOPUT_VSCREENINFO, &var) < 0) {
+			var.yres_virtual = var.yres;
+			if (ioctl(s_fd, FBIOPUT_VSCREENINFO, &var) < 0)
+				return -1;
+		}
+	}
+
+	if (ioctl(s_fd, FBIOGET_VSCREENINFO, &s_fb_var) < 0)
+		return -1;
+	if (s_fb_var.bits_per_pixel != 16 || s_fb_var.xres < HWOUT_WIDTH || s_fb_var.yres < HWOUT_HEIGHT)
+		return -1;
+	s_fb_double = s_fb_var.yres_virtual >= s_fb_var.yres * 2;
+	return 0;
+}
+
+static int FBDevMapFrames(void) {
+	struct fb_fix_screeninfo fix;
+
+	if (ioctl(s_fd, FBIOGET_FSCREENINFO, &fix) < 0)
+		return -1;
+
+	if (!s_fb_mem || s_fb_len != fix.smem_len) {
+		if (s_fb_mem)
+			munmap(s_fb_mem, s_fb_len);
+		s_fb_len = fix.smem_len;
+		s_fb_mem = (uint8 *) mmap(NULL, s_fb_len, PROT_READ | PROT_WRITE, MAP_SHARED, s_fd, 0);
+		if (s_fb_mem == MAP_FAILED) {
+			s_fb_mem = NULL;
+			return -1;
+		}
+	}
+
+	s_pitch = fix.line_length / sizeof(uint16);
+	for (int i = 0; i < 2; i++) {
+		int page = s_fb_double ? i : 0;
+		int y = page * s_fb_var.yres + (s_fb_var.yres - HWOUT_HEIGHT) / 2;
+		int x = (s_fb_var.xres - HWOUT_WIDTH) / 2;
+		s_frame[i] = (uint16 *) (s_fb_mem + y * fix.line_length) + x;
+	}
+	memset(s_fb_mem, 0, s_fb_len);
+	s_back = s_fb_double ? 1 : 0;
+	return 0;
+}
+
+static int FBDevInit(const char *device) {
+	s_fd = open(device, O_RDWR);
+	if (s_fd < 0) {
+		fprintf(stderr, "Error opening %s: %s\n", device, strerror(errno));
+		return -1;
+	}
+	if (ioctl(s_fd, FBIOGET_VSCREENINFO, &s_fb_orig) < 0 || FBDevSetMode() < 0 || FBDevMapFrames() < 0) {
+		fprintf(stderr, "Error setting up %s for 256x240 RGB565\n", device);
+		ioctl(s_fd, FBIOPUT_VSCREENINFO, &s_fb_orig);
+		close(s_fd);
+		s_fd = -1;
+		return -1;
+	}
+
+	return 0;
+}
+
+static void FBDevFlip(void) {
+	if (!s_fb_double)
+		return;
+
+	__u32 crtc = 0;
+	s_fb_var.yoffset = s_back * s_fb_var.yres;
+	ioctl(s_fd, FBIOPAN_DISPLAY, &s_fb_var);
+	/* the old front page is free once the pan has taken effect */
+	ioctl(s_fd, FBIO_WAITFORVSYNC, &crtc);
+	s_back ^= 1;
+}
+
+static void FBDevKill(void) {
+	ioctl(s_fd, FBIOPUT_VSCREENINFO, &s_fb_orig);
+	if (s_fb_mem)
+		munmap(s_fb_mem, s_fb_len);
+	s_fb_mem = NULL;
+	s_fb_len = 0;
+}
+
+/* ------------------------------------------------------------------------ */
+/* KMS                                                                      */
+/* ------------------------------------------------------------------------ */
+
+typedef struct {
+	uint32 handle;
+	uint32 fb_id;
+	uint32 pitch;
+	uint64 size;
+	uint8 *map;
+} KMSBuffer;
+
+static KMSBuffer s_kms_buf[2];
+static KMSBuffer s_kms_bg;		// black mode sized buffer under the plane
+static uint32 s_kms_conn;
+static uint32 s_kms_crtc;
+static int s_kms_crtc_index;
+static uint32 s_kms_plane;
+static struct drm_mode_modeinfo s_kms_mode;
+static struct drm_mode_crtc s_kms_saved;	// to restore the console on exit
+static bool s_kms_scaled;		// frames go through a scaling plane
+static bool s_kms_flip_pending;	// page flip or vblank event not yet received
+
+static int KMSCreateBuffer(KMSBuffer *b, int w, int h) {
+	struct drm_mode_create_dumb creq;
+	struct drm_mode_fb_cmd fcmd;
+	struct drm_mode_map_dumb mreq;
+
+	memset(b, 0, sizeof(*b));
+
+	memset(&creq, 0, sizeof(creq));
+	creq.width = w;
+	creq.height = h;
+	creq.bpp = 16;
+	if (ioctl(s_fd, DRM_IOCTL_MODE_CREATE_DUMB, &creq) < 0)
+		return -1;
+	b->handle = creq.handle;
+	b->pitch = creq.pitch;
+	b->size = creq.size;
+
+	memset(&fcmd, 0, sizeof(fcmd));
+	fcmd.width = w;
+	fcmd.height = h;
+	fcmd.pitch = creq.pitch;
+	fcmd.bpp = 16;
+	fcmd.depth = 16;
+	fcmd.handle = creq.handle;
+	if (ioctl(s_fd, DRM_IOCTL_MODE_ADDFB, &fcmd) < 0)
+		return -1;
+	b->fb_id = fcmd.fb_id;
+
+	memset(&mreq, 0, sizeof(mreq));
+	mreq.handle = creq.handle;
+	if (ioctl(s_fd, DRM_IOCTL_MODE_MAP_DUMB, &mreq) < 0)
+		return -1;
+	b->map = (uint8 *) mmap(NULL, b->size, PROT_READ | PROT_WRITE, MAP_SHARED, s_fd, mreq.offset);
+	if (b->map == MAP_FAILED) {
+		b->map = NULL;
+		return -1;
+	}
+
+	memset(b->map, 0, b->size);
+	return 0;
+}
+
+static void KMSDestroyBuffer(KMSBuffer *b) {
+	if (b->map)
+		munmap(b->map, b->size);
+	if (b->fb_id)
+		ioctl(s_fd, DRM_IOCTL_MODE_RMFB, &b->fb_id);
+	if (b->handle) {
+		struct drm_mode_destroy_dumb dreq;
+		memset(&dreq, 0, sizeof(dreq));
+		dreq.handle = b->handle;
+		ioctl(s_fd, DRM_IOCTL_MODE_DESTROY_DUMB, &dreq);
+	}
+	memset(b, 0, sizeof(*b));
+}
+
+/**
+ * Picks the first connected connector, its preferred mode and a CRTC
+ * that can drive it. Returns 0 on success, -1 on failure.
+ */
+static int KMSFindOutput(void) {
+	struct drm_mode_card_res res;
+	uint32 *conns = NULL, *crtcs = NULL;
+	int ret = -1;
+
+	memset(&res, 0, sizeof(res));
+	if (ioctl(s_fd, DRM_IOCTL_MODE_GETRESOURCES, &res) < 0 || !res.count_connectors || !res.count_crtcs)
+		return -1;
+
+	conns = (uint32 *) calloc(res.count_connectors, sizeof(uint32));
+	crtcs = (uint32 *) calloc(res.count_crtcs, sizeof(uint32));
+	res.connector_id_ptr = (uintptr_t) conns;
+	res.crtc_id_ptr = (uintptr_t) crtcs;
+	res.count_fbs = 0;
+	res.count_encoders = 0;
+	if (ioctl(s_fd, DRM_IOCTL_MODE_GETRESOURCES, &res) < 0)
+		goto out;
+
+	for (uint32 i = 0; i < res.count_connectors && ret < 0; i++) {
+		struct drm_mode_get_connector conn;
+		struct drm_mode_modeinfo *modes;
+		uint32 *encoders;
+
+		memset(&conn, 0, sizeof(conn));
+		conn.connector_id = conns[i];
+		if (ioctl(s_fd, DRM_IOCTL_MODE_GETCONNECTOR, &conn) < 0)
+			continue;
+		if (conn.connection != DRM_MODE_CONNECTED || !conn.count_modes || !conn.count_encoders)
+			continue;
+
+		modes = (struct drm_mode_modeinfo *) calloc(conn.count_modes, sizeof(*modes));
+		encoders = (uint32 *) calloc(conn.count_encoders, sizeof(uint32));
+		conn.modes_ptr = (uintptr_t) modes;
+		conn.encoders_ptr = (uintptr_t) encoders;
+		conn.count_props = 0;
+		if (ioctl(s_fd, DRM_IOCTL_MODE_GETCONNECTOR, &conn) == 0 && conn.count_modes) {
+			s_kms_mode = modes[0];
+			for (uint32 m = 0; m < conn.count_modes; m++) {
+				if (modes[m].type & DRM_MODE_TYPE_PREFERRED) {
+					s_kms_mode = modes[m];
+					break;
+				}
+			}
+
+			/* the CRTC already driving the connector, or the first one allowed */
+			for (uint32 e = 0; e < conn.count_encoders && ret < 0; e++) {
+				struct drm_mode_get_encoder enc;
+				memset(&enc, 0, sizeof(enc));
+				enc.encoder_id = encoders[e];
+				if (ioctl(s_fd, DRM_IOCTL_MODE_GETENCODER, &enc) < 0)
+					continue;
+				for (uint32 c = 0; c < res.count_crtcs; c++) {
+					if ((enc.crtc_id && crtcs[c] == enc.crtc_id) ||
+							(!enc.crtc_id && (enc.possible_crtcs & (1 << c)))) {
+						s_kms_conn = conn.connector_id;
+						s_kms_crtc = crtcs[c];
+						s_kms_crtc_index = c;
+						ret = 0;
+						break;
+					}
+				}
+			}
+		}
+		free(modes);
+		free(encoders);
+	}
+
+out:
+	free(conns);
+	free(crtcs);
+	return ret;
+}
+
+/**
+ * Returns an overlay plane usable on our CRTC, or 0.
+ */
+static uint32 KMSFindPlane(void) {
+	struct drm_mode_get_plane_res pres;
+	uint32 *ids, found = 0;
+
+	memset(&pres, 0, sizeof(pres));
+	if (ioctl(s_fd, DRM_IOCTL_MODE_GETPLANERESOURCES, &pres) < 0 || !pres.count_planes)
+		return 0;
+
+	ids = (uint32 *) calloc(pres.count_planes, sizeof(uint32));
+	pres.plane_id_ptr = (uintptr_t) ids;
+	if (ioctl(s_fd, DRM_IOCTL_MODE_GETPLANERESOURCES, &pres) == 0) {
+		for (uint32 i = 0; i < pres.count_planes && !found; i++) {
+			struct drm_mode_get_plane plane;
+			memset(&plane, 0, sizeof(plane));
+			plane.plane_id = ids[i];
+			if (ioctl(s_fd, DRM_IOCTL_MODE_GETPLANE, &plane) == 0 &&
+					(plane.possible_crtcs & (1 << s_kms_crtc_index)))
+				found = ids[i];
+		}
+	}
+	free(ids);
+	return found;
+}
+
+static int KMSSetCrtc(uint32 fb_id) {
+	struct drm_mode_crtc crtc;
+
+	memset(&crtc, 0, sizeof(crtc));
+	crtc.crtc_id = s_kms_crtc;
+	crtc.fb_id = fb_id;
+	crtc.set_connectors_ptr = (uintptr_t) &s_kms_conn;
+	crtc.count_connectors = 1;
+	crtc.mode = s_kms_mode;
+	crtc.mode_valid = 1;
+	return ioctl(s_fd, DRM_IOCTL_MODE_SETCRTC, &crtc);
+}
+
+/**
+ * Shows a frame buffer through the overlay plane, scaled to the screen
+ * height with square pixels.
+ */
+static int KMSSetPlane(uint32 fb_id) {
+	struct drm_mode_set_plane sp;
+	int w = s_kms_mode.hdisplay, h = s_kms_mode.vdisplay;
+
+	if (w * HWOUT_HEIGHT > h * HWOUT_WIDTH)
+		w = h * HWOUT_WIDTH / HWOUT_HEIGHT;
+	else
+		h = w * HWOUT_HEIGHT / HWOUT_WIDTH;
+
+	memset(&sp, 0, sizeof(sp));
+	sp.plane_id = s_kms_plane;
+	sp.crtc_id = s_kms_crtc;
+	sp.fb_id = fb_id;
+	sp.crtc_x = (s_kms_mode.hdisplay - w) / 2;
+	sp.crtc_y = (s_kms_mode.vdisplay - h) / 2;
+	sp.crtc_w = w;
+	sp.crtc_h = h;
+	sp.src_w = HWOUT_WIDTH << 16;
+	sp.src_h = HWOUT_HEIGHT << 16;
+	return ioctl(s_fd, DRM_IOCTL_MODE_SETPLANE, &sp);
+}
+
+/**
+ * Asks for an event at the next vblank of our CRTC. KMSWaitFlip() waits
+ * for it like for a page flip.
+ */
+static void KMSQueueVBlank(void) {
+	union drm_wait_vblank vbl;
+	uint32 crtc = 0;
+
+	if (s_kms_crtc_index == 1)
+		crtc = _DRM_VBLANK_SECONDARY;
+	else if (s_kms_crtc_index > 1)
+		crtc = (s_kms_crtc_index << _DRM_VBLANK_HIGH_CRTC_SHIFT) & _DRM_VBLANK_HIGH_CRTC_MASK;
+
+	memset(&vbl, 0, sizeof(vbl));
+	vbl.request.type = (enum drm_vblank_seq_type) (_DRM_VBLANK_RELATIVE | _DRM_VBLANK_EVENT | crtc);
+	vbl.request.sequence = 1;
+	if (ioctl(s_fd, DRM_IOCTL_WAIT_VBLANK, &vbl) == 0)
+		s_kms_flip_pending = true;
+}
+
+static void KMSWaitFlip(void) {
+	char buf[256];
+
+	while (s_kms_flip_pending) {
+		struct pollfd pfd;
+		pfd.fd = s_fd;
+		pfd.events = POLLIN;
+		pfd.revents = 0;
+
+		/* don't hang forever if the event got lost */
+		if (poll(&pfd, 1, 100) <= 0) {
+			s_kms_flip_pending = false;
+			break;
+		}
+
+		int len = read(s_fd, buf, sizeof(buf));
+		if (len <= 0) {
+			s_kms_flip_pending = false;
+			break;
+		}
+		for (int i = 0; i + (int) sizeof(struct drm_event) <= len; ) {
+			struct drm_event *e = (struct drm_event *) (buf + i);
+			if (e->type == DRM_EVENT_FLIP_COMPLETE || e->type == DRM_EVENT_VBLANK)
+				s_kms_flip_pending = false;
+			if (!e->length)
+				break;
+			i += e->length;
+		}
+	}
+}
+
+static void KMSMapFrames(void) {
+	for (int i = 0; i < 2; i++) {
+		KMSBuffer *b = &s_kms_buf[i];
+		int x = 0, y = 0;
+		if (!s_kms_scaled) {
+			x = (s_kms_mode.hdisplay - HWOUT_WIDTH) / 2;
+			y = (s_kms_mode.vdisplay - HWOUT_HEIGHT) / 2;
+		}
+		s_frame[i] = (uint16 *) (b->map + y * b->pitch) + x;
+	}
+	s_pitch = s_kms_buf[0].pitch / sizeof(uint16);
+}
+
+/**
+ * Tries the overlay plane first and falls back to page flipping two mode
+ * sized buffers on the CRTC. Returns 0 on success, -1 on failure.
+ */
+static int KMSShow(void) {
+	if (s_kms_scaled) {
+		if (KMSSetCrtc(s_kms_bg.fb_id) < 0 || KMSSetPlane(s_kms_buf[0].fb_id) < 0)
+			return -1;
+		s_back = 1;
+		return 0;
+	}
+
+	if (KMSSetCrtc(s_kms_buf[0].fb_id) < 0)
+		return -1;
+	s_back = 1;
+	return 0;
+}
+
+static int KMSInit(const char *device) {
+	s_fd = open(device, O_RDWR | O_CLOEXEC);
+	if (s_fd < 0) {
+		fprintf(stderr, "Error opening %s: %s\n", device, strerror(errno));
+		return -1;
+	}
+
+	if (KMSFindOutput() < 0) {
+		fprintf(stderr, "No connected output on %s\n", device);
+		goto fail;
+	}
+
+	memset(&s_kms_saved, 0, sizeof(s_kms_saved));
+	s_kms_saved.crtc_id = s_kms_crtc;
+	ioctl(s_fd, DRM_IOCTL_MODE_GETCRTC, &s_kms_saved);
+
+	s_kms_plane = KMSFindPlane();
+	s_kms_scaled = false;
+	if (s_kms_plane &&
+			KMSCreateBuffer(&s_kms_bg, s_kms_mode.hdisplay, s_kms_mode.vdisplay) == 0 &&
+			KMSCreateBuffer(&s_kms_buf[0], HWOUT_WIDTH, HWOUT_HEIGHT) == 0 &&
+			KMSCreateBuffer(&s_kms_buf[1], HWOUT_WIDTH, HWOUT_HEIGHT) == 0) {
+		s_kms_scaled = true;
+		if (KMSShow() < 0)
+			s_kms_scaled = false;
+	}
+
+	if (!s_kms_scaled) {
+		/* no usable scaler: flip mode sized buffers, frame centered */
+		KMSDestroyBuffer(&s_kms_bg);
+		KMSDestroyBuffer(&s_kms_buf[0]);
+		KMSDestroyBuffer(&s_kms_buf[1]);
+		if (s_kms_mode.hdisplay < HWOUT_WIDTH || s_kms_mode.vdisplay < HWOUT_HEIGHT ||
+				KMSCreateBuffer(&s_kms_buf[0], s_kms_mode.hdisplay, s_kms_mode.vdisplay) < 0 ||
+				KMSCreateBuffer(&s_kms_buf[1], s_kms_mode.hdisplay, s_kms_mode.vdisplay) < 0 ||
+				KMSShow() < 0) {
+			fprintf(stderr, "Error setting mode %s on %s: %s\n", s_kms_mode.name, device, strerror(errno));
+			goto fail;
+		}
+	}
+
+	KMSMapFrames();
+	s_kms_flip_pending = false;
+	return 0;
+
+fail:
+	KMSDestroyBuffer(&s_kms_bg);
+	KMSDestroyBuffer(&s_kms_buf[0]);
+	KMSDestroyBuffer(&s_kms_buf[1]);
+	close(s_fd);
+	s_fd = -1;
+	return -1;
+}
+
+static void KMSFlip(void) {
+	KMSBuffer *b = &s_kms_buf[s_back];
+
+	if (s_kms_scaled) {
+		/* Legacy SETPLANE has no completion event. Depending on the driver
+		   the new buffer is latched at once or at the next vblank, so the
+		   old one is only known to be off the screen once that vblank has
+		   passed. If the driver switches at once, the swap can tear. */
+		KMSSetPlane(b->fb_id);
+		KMSQueueVBlank();
+	} else {
+		struct drm_mode_crtc_page_flip flip;
+		memset(&flip, 0, sizeof(flip));
+		flip.crtc_id = s_kms_crtc;
+		flip.fb_id = b->fb_id;
+		flip.flags = DRM_MODE_PAGE_FLIP_EVENT;
+		if (ioctl(s_fd, DRM_IOCTL_MODE_PAGE_FLIP, &flip) == 0)
+			s_kms_flip_pending = true;
+		else
+			KMSSetCrtc(b->fb_id);
+	}
+	s_back ^= 1;
+}
+
+/**
+ * Puts back whatever was on the CRTC before, usually the console or the
+ * fbdev emulation SDL draws to.
+ */
+static void KMSRestore(void) {
+	KMSWaitFlip();
+	if (s_kms_scaled) {
+		struct drm_mode_set_plane sp;
+		memset(&sp, 0, sizeof(sp));
+		sp.plane_id = s_kms_plane;
+		sp.crtc_id = s_kms_crtc;
+		ioctl(s_fd, DRM_IOCTL_MODE_SETPLANE, &sp);
+	}
+	if (s_kms_saved.mode_valid && s_kms_saved.fb_id) {
+		s_kms_saved.set_connectors_ptr = (uintptr_t) &s_kms_conn;
+		s_kms_saved.count_connectors = 1;
+		ioctl(s_fd, DRM_IOCTL_MODE_SETCRTC, &s_kms_saved);
+	}
+}
+
+static void KMSKill(void) {
+	KMSRestore();
+	KMSDestroyBuffer(&s_kms_bg);
+	KMSDestroyBuffer(&s_kms_buf[0]);
+	KMSDestroyBuffer(&s_kms_buf[1]);
+}
+
+/* ------------------------------------------------------------------------ */
+
+int HWOut_Init(int backend, const char *device) {
+	int ret = -1;
+
+	if (s_backend != HWOUT_NONE)
+		HWOut_Kill();
+
+	switch (backend) {
+		case HWOUT_FBDEV:
+		ret = FBDevInit(device && device[0] ? device : "/dev/fb0");
+		break;
+
+		case HWOUT_KMS:
+		ret = KMSInit(device && device[0] ? device : "/dev/dri/card0");
+		break;
+
+		default:
+		return -1;
+	}
+
+	if (ret < 0)
+		return -1;
+
+	s_backend = backend;
+	s_suspended = false;
+	ClearFrames();
+	return 0;
+}
+
+void HWOut_Kill(void) {
+	if (s_backend == HWOUT_FBDEV)
+		FBDevKill();
+	else if (s_backend == HWOUT_KMS)
+		KMSKill();
+
+	if (s_fd >= 0)
+		close(s_fd);
+	s_fd = -1;
+	s_backend = HWOUT_NONE;
+}
+
+uint16 *HWOut_BeginFrame(int *pitch) {
+	if (s_backend == HWOUT_KMS)
+		KMSWaitFlip();
+
+	*pitch = s_pitch;
+	return s_frame[s_back];
+}
+
+void HWOut_EndFrame(void) {
+	if (s_suspended)
+		return;
+
+	if (s_backend == HWOUT_FBDEV)
+		FBDevFlip();
+	else if (s_backend == HWOUT_KMS)
+		KMSFlip();
+}
+
+void HWOut_Suspend(void) {
+	if (s_backend == HWOUT_NONE || s_suspended)
+		return;
+
+	if (s_backend == HWOUT_FBDEV)
+		ioctl(s_fd, FBIOPUT_VSCREENINFO, &s_fb_orig);
+	else if (s_backend == HWOUT_KMS)
+		KMSRestore();
+	s_suspended = true;
+}
+
+void HWOut_Resume(void) {
+	if (s_backend == HWOUT_NONE || !s_suspended)
+		return;
+
+	if (s_backend == HWOUT_FBDEV) {
+		if (FBDevSetMode() < 0 || FBDevMapFrames() < 0) {
+			fprintf(stderr, "Error restoring the fbdev output mode\n");
+			HWOut_Kill();
+			return;
+		}
+	} else if (s_backend == HWOUT_KMS) {
+		if (KMSShow() < 0) {
+			fprintf(stderr, "Error restoring the KMS output\n");
+			HWOut_Kill();
+			return;
+		}
+	}
+	s_suspended = false;
+}
+
+int HWOut_Active(void) {
+	return s_backend != HWOUT_NONE;
+}
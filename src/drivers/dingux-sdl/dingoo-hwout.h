@@ -0,0 +1,34 @@
+#ifndef __DINGOO_HWOUT__
+#define __DINGOO_HWOUT__
+
+#include "../../types.h"
+
+/* Native NES frame size handed to the display hardware */
+#define HWOUT_WIDTH		256
+#define HWOUT_HEIGHT	240
+
+enum {
+	HWOUT_NONE,		// software scaling into hw_screen (SDL)
+	HWOUT_FBDEV,	// /dev/fb0, double buffered with FBIOPAN_DISPLAY
+	HWOUT_KMS		// DRM/KMS dumb buffers, page flipped
+};
+
+/* Opens the display device and sets up two 256x240 RGB565 buffers.
+   An empty device selects /dev/fb0 or /dev/dri/card0. Returns 0 on
+   success, -1 on failure. */
+int HWOut_Init(int backend, const char *device);
+void HWOut_Kill(void);
+
+/* Returns the back buffer to draw the next frame into, waiting for the
+   previous flip to complete first. Pitch is in pixels. */
+uint16 *HWOut_BeginFrame(int *pitch);
+/* Shows the back buffer at the next vblank */
+void HWOut_EndFrame(void);
+
+/* Gives the display back to SDL (menu) and takes it again */
+void HWOut_Suspend(void);
+void HWOut_Resume(void);
+
+int HWOut_Active(void);
+
+#endif // __DINGOO_HWOUT__
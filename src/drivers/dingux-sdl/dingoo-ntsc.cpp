@@ -0,0 +1,114 @@
+/* FCE Ultra - NES/Famicom Emulator
+ *
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation; either version 2 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307  USA
+ */
+
+/// \file
+/// \brief RGB565 nes_ntsc blitter for the dingux driver.
+///
+/// This is a custom blitter built on the nes_ntsc row macros (see
+/// "Interface for user-defined custom blitters" in nes_ntsc.h). The stock
+/// nes_ntsc_blit always writes 32-bit output pixels, this one writes
+/// RGB565 directly so the result can be scaled into hw_screen.
+
+#include "dingoo-ntsc.h"
+
+#if defined(__ARM_NEON__) && !defined(__aarch64__)
+#include <arm_neon.h>
+#define DINGOO_NTSC_NEON
+#endif
+
+#ifdef DINGOO_NTSC_NEON
+/*
+ * Generates output pixels x and x+1 at once. For x = 0, 2 and 4 the six
+ * kernel entries of both pixels are adjacent in the table, so each kernel
+ * is read with a single 2-lane load. nes_ntsc_rgb_t is 32 bits wide on ARM.
+ */
+#define DINGOO_NTSC_OUT_PAIR( x, rgb_out ) {\
+	uint32x2_t raw_ = vld1_u32( (uint32_t const*) kernel0 + (x) );\
+	raw_ = vadd_u32( raw_, vld1_u32( (uint32_t const*) kernel1  + ((x)+12)%7+14 ) );\
+	raw_ = vadd_u32( raw_, vld1_u32( (uint32_t const*) kernel2  + ((x)+10)%7+28 ) );\
+	raw_ = vadd_u32( raw_, vld1_u32( (uint32_t const*) kernelx0 + ((x)+7)%14 ) );\
+	raw_ = vadd_u32( raw_, vld1_u32( (uint32_t const*) kernelx1 + ((x)+ 5)%7+21 ) );\
+	raw_ = vadd_u32( raw_, vld1_u32( (uint32_t const*) kernelx2 + ((x)+ 3)%7+35 ) );\
+	/* NES_NTSC_CLAMP_ */\
+	uint32x2_t sub_ = vand_u32( vshr_n_u32( raw_, 9 ), vdup_n_u32( nes_ntsc_clamp_mask ) );\
+	uint32x2_t clamp_ = vsub_u32( vdup_n_u32( nes_ntsc_clamp_add ), sub_ );\
+	raw_ = vorr_u32( raw_, clamp_ );\
+	clamp_ = vsub_u32( clamp_, sub_ );\
+	raw_ = vand_u32( raw_, clamp_ );\
+	/* NES_NTSC_RGB_OUT_ with 16 bits */\
+	uint32x2_t rgb_ = vorr_u32(\
+		vorr_u32( vand_u32( vshr_n_u32( raw_, 13 ), vdup_n_u32( 0xF800 ) ),\
+		          vand_u32( vshr_n_u32( raw_,  8 ), vdup_n_u32( 0x07E0 ) ) ),\
+		vand_u32( vshr_n_u32( raw_, 4 ), vdup_n_u32( 0x001F ) ) );\
+	uint16x4_t rgb16_ = vmovn_u32( vcombine_u32( rgb_, rgb_ ) );\
+	vst1_lane_u16( &(rgb_out) [(x)    ], rgb16_, 0 );\
+	vst1_lane_u16( &(rgb_out) [(x) + 1], rgb16_, 1 );\
+}
+#else
+#define DINGOO_NTSC_OUT_PAIR( x, rgb_out ) {\
+	NES_NTSC_RGB_OUT( (x)    , (rgb_out) [(x)    ], 16 );\
+	NES_NTSC_RGB_OUT( (x) + 1, (rgb_out) [(x) + 1], 16 );\
+}
+#endif
+
+void dingoo_ntsc_blit16(nes_ntsc_t const *ntsc, uint8 const *input, long in_row_width,
+		int burst_phase, int emphasis, int in_width, int in_height,
+		uint16 *rgb_out, long out_pitch)
+{
+	int chunk_count = (in_width - 1) / nes_ntsc_in_chunk;
+
+	for ( ; in_height; --in_height)
+	{
+		uint8 const *line_in = input;
+		NES_NTSC_BEGIN_ROW( ntsc, burst_phase, nes_ntsc_black, nes_ntsc_black, NES_NTSC_ADJ_IN( *line_in ) );
+		uint16 *line_out = rgb_out;
+		int n;
+		++line_in;
+
+		for (n = chunk_count; n; --n)
+		{
+			/* order of input and output pixels must not be altered */
+			NES_NTSC_COLOR_IN( 0, NES_NTSC_ADJ_IN( line_in [0] ) );
+			DINGOO_NTSC_OUT_PAIR( 0, line_out );
+
+			NES_NTSC_COLOR_IN( 1, NES_NTSC_ADJ_IN( line_in [1] ) );
+			DINGOO_NTSC_OUT_PAIR( 2, line_out );
+
+			NES_NTSC_COLOR_IN( 2, NES_NTSC_ADJ_IN( line_in [2] ) );
+			DINGOO_NTSC_OUT_PAIR( 4, line_out );
+			NES_NTSC_RGB_OUT( 6, line_out [6], 16 );
+
+			line_in  += 3;
+			line_out += DINGOO_NTSC_OUT_CHUNK;
+		}
+
+		/* finish final pixels */
+		NES_NTSC_COLOR_IN( 0, nes_ntsc_black );
+		DINGOO_NTSC_OUT_PAIR( 0, line_out );
+
+		NES_NTSC_COLOR_IN( 1, nes_ntsc_black );
+		DINGOO_NTSC_OUT_PAIR( 2, line_out );
+
+		NES_NTSC_COLOR_IN( 2, nes_ntsc_black );
+		DINGOO_NTSC_OUT_PAIR( 4, line_out );
+		NES_NTSC_RGB_OUT( 6, line_out [6], 16 );
+
+		rgb_out = (uint16 *) ((char *) rgb_out + out_pitch);
+		burst_phase = (burst_phase + 1) % nes_ntsc_burst_count;
+		input += in_row_width;
+	}
+}
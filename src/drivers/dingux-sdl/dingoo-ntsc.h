@@ -0,0 +1,17 @@
+#ifndef __DINGOO_NTSC__
+#define __DINGOO_NTSC__
+
+#include "../../types.h"
+#include "../common/nes_ntsc.h"
+
+/* 3 input pixels -> 7 output pixels, 256 input pixels -> 602 output pixels */
+#define DINGOO_NTSC_OUT_CHUNK	7
+#define DINGOO_NTSC_OUT_WIDTH	(((256 - 1) / nes_ntsc_in_chunk + 1) * DINGOO_NTSC_OUT_CHUNK)
+
+/* Same as nes_ntsc_blit, but always outputs RGB565 and uses NEON when
+   available. Out_pitch is the number of *bytes* to get to the next row. */
+void dingoo_ntsc_blit16(nes_ntsc_t const *ntsc, uint8 const *input, long in_row_width,
+		int burst_phase, int emphasis, int in_width, int in_height,
+		uint16 *rgb_out, long out_pitch);
+
+#endif // __DINGOO_NTSC__
@@ -0,0 +1,163 @@
+/* FCE Ultra - NES/Famicom Emulator
+ *
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation; either version 2 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307  USA
+ */
+
+/// \file
+/// \brief Instant Play resume images for the dingux driver.
+///
+/// Switching the console off writes the running game out in the form that is
+/// quickest to bring back: the raw state (FCEUSS_SaveRaw, no chunks and no
+/// compression), the picture that was on screen and the menu settings, with
+/// the ROM's MD5 and the state layout to make sure they still fit. The next
+/// boot maps the file, shows the picture as soon as video is up and copies
+/// the state straight out of the mapping.
+///
+/// The layout only matches the build that wrote it, so the ordinary
+/// quicksave is still written next to it as the fallback.
+
+#include <stdio.h>
+#include <string.h>
+#include <fcntl.h>
+#include <unistd.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <vector>
+
+#include "../../fceu.h"
+#include "../../git.h"
+#include "../../state.h"
+#include "../../video.h"
+#include "../../rewind.h"
+#include "../../utils/asyncio.h"
+
+#include "dface.h"
+#include "menu.h"
+#include "configfile.h"
+#include "dingoo-resume.h"
+
+#define RESUME_MAGIC		"FCEURSM\x1a"
+#define RESUME_VERSION		1
+#define RESUME_FRAMESIZE	(256 * 240)		// palette indices, like XBuf
+#define RESUME_ALIGN(x)		(((x) + 15) & ~15)
+
+struct RESUMEHEADER
+{
+	char magic[8];
+	uint32 version;
+	uint32 layout;					// FCEUSS_RawLayout of the writer
+	uint8 md5[16];					// the ROM's
+	uint32 frameOffset;				// RESUME_FRAMESIZE bytes
+	uint32 stateOffset, stateSize;	// FCEUSS_SaveRaw
+	// menu settings
+	uint32 aspectRatio, aspectRatioFactor;
+	int32 volume, brightness;
+	int32 slot;
+};
+
+extern int savestate_slot;
+
+bool Resume_Save(const char *fname) {
+	if (!GameInfo)
+		return false;
+
+	RESUMEHEADER h;
+	memset(&h, 0, sizeof(h));
+	memcpy(h.magic, RESUME_MAGIC, 8);
+	h.version = RESUME_VERSION;
+	h.layout = FCEUSS_RawLayout();
+	memcpy(h.md5, &GameInfo->MD5, sizeof(h.md5));
+	h.frameOffset = RESUME_ALIGN(sizeof(h));
+	h.stateOffset = RESUME_ALIGN(h.frameOffset + RESUME_FRAMESIZE);
+	h.stateSize = FCEUSS_RawSize();
+	h.aspectRatio = aspect_ratio;
+	h.aspectRatioFactor = aspect_ratio_factor_percent;
+	h.volume = volume_percentage;
+	h.brightness = brightness_percentage;
+	h.slot = savestate_slot;
+
+	std::vector<uint8> buf(h.stateOffset + h.stateSize);
+	memcpy(&buf[0], &h, sizeof(h));
+	memcpy(&buf[h.frameOffset], FCEU_GetBackBuf(), RESUME_FRAMESIZE);
+	FCEUSS_SaveRaw(&buf[h.stateOffset]);
+
+	return FCEU_WriteFileAtomic(fname, &buf[0], buf.size());
+}
+
+static void RunShellCmd(const char *cmd, int value) {
+	char shell_cmd[100];
+	sprintf(shell_cmd, "%s %d", cmd, value);
+	if (popen(shell_cmd, "r") == NULL)
+		printf("Failed to run command %s\n", shell_cmd);
+}
+
+bool Resume_Load(const char *fname) {
+	if (!GameInfo)
+		return false;
+
+	int fd = open(fname, O_RDONLY);
+	if (fd < 0)
+		return false;
+	struct stat st;
+	if (fstat(fd, &st) || st.st_size < (off_t)sizeof(RESUMEHEADER)) {
+		close(fd);
+		return false;
+	}
+	size_t len = st.st_size;
+	void *map = mmap(0, len, PROT_READ, MAP_PRIVATE, fd, 0);
+	close(fd);
+	if (map == MAP_FAILED)
+		return false;
+
+	const uint8 *data = (const uint8 *)map;
+	RESUMEHEADER h;
+	memcpy(&h, data, sizeof(h));
+
+	bool ok = !memcmp(h.magic, RESUME_MAGIC, 8)
+		&& h.version == RESUME_VERSION
+		&& h.layout == FCEUSS_RawLayout()
+		&& h.stateSize == FCEUSS_RawSize()
+		&& !memcmp(h.md5, &GameInfo->MD5, sizeof(h.md5))
+		&& h.frameOffset <= len && len - h.frameOffset >= RESUME_FRAMESIZE
+		&& h.stateOffset <= len && h.stateSize <= len - h.stateOffset;
+
+	if (ok) {
+		// settings first, the picture is drawn with them
+		if (h.aspectRatio < NB_ASPECT_RATIOS_TYPES)
+			aspect_ratio = h.aspectRatio;
+		aspect_ratio_factor_percent = h.aspectRatioFactor;
+		savestate_slot = h.slot;
+		// -1 if the menu never read them in that session
+		if (h.volume >= 0) {
+			volume_percentage = h.volume;
+			RunShellCmd(SHELL_CMD_VOLUME_SET, volume_percentage);
+		}
+		if (h.brightness >= 0) {
+			brightness_percentage = h.brightness;
+			RunShellCmd(SHELL_CMD_BRIGHTNESS_SET, brightness_percentage);
+		}
+
+		memcpy(XBackBuf, data + h.frameOffset, RESUME_FRAMESIZE);
+		FCEU_BackBufLoaded();
+		FCEU_RestoreBackBuf();
+		BlitScreen(XBuf);
+
+		FCEUSS_LoadRaw(data + h.stateOffset);
+		FCEU_RewindReset();
+	}
+
+	munmap(map, len);
+	return ok;
+}
@@ -0,0 +1,15 @@
+#ifndef __DINGOO_RESUME__
+#define __DINGOO_RESUME__
+
+/* Writes an Instant Play resume image of the running game to fname:
+   the ROM's MD5, its raw state, the menu settings and the current
+   picture. Returns false if there is no game or the write failed. */
+bool Resume_Save(const char *fname);
+
+/* Restores a resume image once the same ROM has been loaded: applies
+   the settings, puts the saved picture on screen and loads the state.
+   Returns false, changing nothing, if the image is missing, damaged, or
+   was written for another ROM or another build. */
+bool Resume_Load(const char *fname);
+
+#endif // __DINGOO_RESUME__
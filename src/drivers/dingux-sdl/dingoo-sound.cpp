@@ -28,7 +28,7 @@
 #include "dingoo.h"
 #include "keyscan.h"
 
-#include "../common/configSys.h"
+#include "config.h"
 
 extern Config *g_config;
 
@@ -83,7 +83,7 @@ int InitSound()
 
     FCEUI_printf("Initializing audio...\n");
 
-    g_config->getOption("SDL.Sound", &sound);
+    g_config->getOption(g_opts.sound, &sound);
     if (!sound) return 0;
 
     memset(&spec, 0, sizeof(spec));
@@ -98,16 +98,16 @@ int InitSound()
     fprintf(stderr, "Loading SDL sound with %s driver...\n", driverName);
 
     // load configuration variables
-    g_config->getOption("SDL.Sound.Rate", &soundrate);
-    g_config->getOption("SDL.Sound.BufSize", &soundbufsize);
-    g_config->getOption("SDL.Sound.Volume", &soundvolume);
-    g_config->getOption("SDL.Sound.Quality", &soundq);
-    g_config->getOption("SDL.Sound.TriangleVolume", &soundtrianglevolume);
-    g_config->getOption("SDL.Sound.Square1Volume", &soundsquare1volume);
-    g_config->getOption("SDL.Sound.Square2Volume", &soundsquare2volume);
-    g_config->getOption("SDL.Sound.NoiseVolume", &soundnoisevolume);
-    g_config->getOption("SDL.Sound.PCMVolume", &soundpcmvolume);
-    g_config->getOption("SDL.Sound.LowPass", &lowpass);
+    g_config->getOption(g_opts.soundRate, &soundrate);
+    g_config->getOption(g_opts.soundBufSize, &soundbufsize);
+    g_config->getOption(g_opts.soundVolume, &soundvolume);
+    g_config->getOption(g_opts.soundQuality, &soundq);
+    g_config->getOption(g_opts.soundTriangleVolume, &soundtrianglevolume);
+    g_config->getOption(g_opts.soundSquare1Volume, &soundsquare1volume);
+    g_config->getOption(g_opts.soundSquare2Volume, &soundsquare2volume);
+    g_config->getOption(g_opts.soundNoiseVolume, &soundnoisevolume);
+    g_config->getOption(g_opts.soundPCMVolume, &soundpcmvolume);
+    g_config->getOption(g_opts.soundLowPass, &lowpass);
 
     spec.freq = soundrate;
     spec.format = AUDIO_S16;
@@ -23,8 +23,11 @@
 
 #include <stdio.h>
 #include <string.h>
+#include <strings.h>
 #include <stdlib.h>
 #include <stdbool.h>
+#include <string>
+#include <time.h>
 #include <SDL/SDL.h>
 #include <SDL/SDL_ttf.h>
 #include <SDL/SDL_image.h>
@@ -34,14 +37,18 @@
 #include "scaler.h"
 #include "menu.h"
 #include "configfile.h"
+#include "dingoo-ntsc.h"
+#include "dingoo-hwout.h"
 
 #include "../common/vidblit.h"
 #include "../../fceu.h"
+#include "../../ppu.h"
 #include "../../version.h"
+#include "../../utils/memory.h"
 
 #include "dface.h"
 
-#include "../common/configSys.h"
+#include "config.h"
 
 // GLOBALS
 SDL_Surface *screen;
@@ -58,6 +65,8 @@ static int s_inited;
 static bool s_VideoModeSet = false;
 
 static int s_clipSides;
+static int s_blitbench;
+static int s_directrender;
 int s_fullscreen;
 static int noframe;
 
@@ -91,6 +100,327 @@ static struct Color s_cpsdl[256];
 #  define DINGOO_MULTIBUF SDL_DOUBLEBUF
 #endif
 
+/**
+ * Scaling plan: everything the NES blitters need to map XBuf onto hw_screen
+ * for the current mode. It only depends on the aspect ratio and on the
+ * rendered line range, so it is built once and reused every frame.
+ */
+#define PLAN_BLEND		0x01	// column needs the gaussian left/right blend
+#define PLAN_BLEND_LEFT		0x02	// blend with the left neighbour
+#define PLAN_BLEND_RIGHT	0x04	// blend with the right neighbour
+
+typedef struct {
+	bool valid;
+
+	/* settings the plan was built for */
+	unsigned int aspect_ratio;
+	int srendline;
+	int tlines;
+	int clip_sides;
+
+	/* destination rectangle, already clipped to the hw screen */
+	int dst_w;
+	int dst_h;
+	int dst_pitch;
+	int y_padding;
+
+	/* source buffer offset of the first source pixel of each destination row */
+	uint32 row_offset[RES_HW_SCREEN_VERTICAL];
+	/* NTSC only: first source row and first destination row of the second band */
+	int band_src_row;
+	int band_dst_row;
+	/* XBuf row of source row 0 and source column of destination column 0,
+	   for rendering single lines */
+	int src_row_base;
+	int src_col_offset;
+	/* first destination row and number of destination rows of each source row */
+	int16 row_dst_first[256];
+	uint8 row_dst_count[256];
+	/* source column of each destination column */
+	uint16 col_map[RES_HW_SCREEN_HORIZONTAL];
+	/* PLAN_BLEND* flags of each destination column */
+	uint8 col_blend[RES_HW_SCREEN_HORIZONTAL];
+} ScalePlan;
+
+static ScalePlan s_plan;
+
+/**
+ * Computes row/column maps, gaussian blend weights and destination
+ * offsets for the current aspect ratio and rendered line range.
+ */
+static void BuildScalePlan(void) {
+	int w1 = 256; //NWIDTH;
+	int h1 = s_tlines;
+	int w2, h2;
+	uint32 src_offset = 0;
+
+	switch (aspect_ratio) {
+		case ASPECT_RATIOS_TYPE_STRETCHED:
+		w2 = RES_HW_SCREEN_HORIZONTAL;
+		h2 = RES_HW_SCREEN_VERTICAL;
+		break;
+
+		case ASPECT_RATIOS_TYPE_NTSC:
+		/* source is the nes_ntsc output buffer, not XBuf */
+		w1 = DINGOO_NTSC_OUT_WIDTH;
+		w2 = RES_HW_SCREEN_HORIZONTAL;
+		h2 = RES_HW_SCREEN_VERTICAL;
+		break;
+
+		case ASPECT_RATIOS_TYPE_CROPPED:
+		default:
+		/* Cropped but not centered yes for some games */
+		aspect_ratio = ASPECT_RATIOS_TYPE_CROPPED;
+		w2 = NWIDTH;
+		h2 = s_tlines;
+		src_offset = (s_srendline * 256) + NOFFSET;
+		break;
+	}
+
+	int x_ratio = (int) ((w1 << 16) / w2);
+	int y_ratio = (int) ((h1 << 16) / h2);
+
+	/// --- Compute padding for centering when out of bounds ---
+	int x_padding = 0;
+	if (w2 > RES_HW_SCREEN_HORIZONTAL) {
+		x_padding = (w2 - RES_HW_SCREEN_HORIZONTAL) / 2 + 1;
+	}
+	int x_padding_ratio = x_padding * w1 / w2;
+
+	s_plan.dst_w = (w2 > RES_HW_SCREEN_HORIZONTAL) ? RES_HW_SCREEN_HORIZONTAL : w2;
+	s_plan.dst_h = (h2 > RES_HW_SCREEN_VERTICAL) ? RES_HW_SCREEN_VERTICAL : h2;
+	s_plan.dst_pitch = s_plan.dst_w;
+	s_plan.y_padding = (RES_HW_SCREEN_VERTICAL - h2) / 2;
+
+	s_plan.band_src_row = h1 / 2;
+	s_plan.band_dst_row = s_plan.dst_h;
+	s_plan.src_row_base = src_offset / 256;
+	s_plan.src_col_offset = src_offset % 256 + x_padding_ratio;
+	memset(s_plan.row_dst_count, 0, sizeof(s_plan.row_dst_count));
+	for (int i = 0; i < s_plan.dst_h; i++) {
+		int y1 = (i * y_ratio) >> 16;
+		s_plan.row_offset[i] = src_offset + y1 * w1 + x_padding_ratio;
+		if (y1 >= s_plan.band_src_row && s_plan.band_dst_row == s_plan.dst_h)
+			s_plan.band_dst_row = i;
+		if (!s_plan.row_dst_count[y1])
+			s_plan.row_dst_first[y1] = i;
+		s_plan.row_dst_count[y1]++;
+	}
+
+	int rat = 0;
+	int px_diff_prev_x = 0;
+	for (int j = 0; j < s_plan.dst_w; j++) {
+		int x1 = rat >> 16;
+		int px_diff_next_x = ((rat + x_ratio) >> 16) - x1;
+		uint8 blend = 0;
+
+		if (px_diff_prev_x > 1 || px_diff_next_x > 1) {
+			blend = PLAN_BLEND;
+			if (px_diff_prev_x > 1 && x1 > 0)
+				blend |= PLAN_BLEND_LEFT;
+			if (px_diff_next_x > 1 && x1 + 1 < w1)
+				blend |= PLAN_BLEND_RIGHT;
+		}
+
+		s_plan.col_map[j] = x1;
+		s_plan.col_blend[j] = blend;
+
+		px_diff_prev_x = px_diff_next_x;
+		rat += x_ratio;
+	}
+
+	s_plan.aspect_ratio = aspect_ratio;
+	s_plan.srendline = s_srendline;
+	s_plan.tlines = s_tlines;
+	s_plan.clip_sides = s_clipSides;
+	s_plan.valid = true;
+}
+
+/**
+ * Rebuilds the scaling plan if the settings it depends on have changed.
+ * Returns true if a new plan was built.
+ */
+static bool UpdateScalePlan(void) {
+	if (s_plan.valid &&
+			s_plan.aspect_ratio == aspect_ratio &&
+			s_plan.srendline == s_srendline &&
+			s_plan.tlines == s_tlines &&
+			s_plan.clip_sides == s_clipSides)
+		return false;
+
+	BuildScalePlan();
+	return true;
+}
+
+/**
+ * NTSC filter state. The filter output is 602 pixels wide, so it is
+ * rendered into s_ntscbuf and then downscaled to the hw screen. The frame
+ * is split in two row bands: the main thread does the top one while
+ * s_ntsc_thread does the bottom one.
+ */
+static nes_ntsc_t *s_ntsc = NULL;
+static uint16 *s_ntscbuf = NULL;
+static int s_ntsc_burst = 0;
+static int s_ntsc_emphasis;
+static uint8 *s_ntsc_src;
+
+static SDL_Thread *s_ntsc_thread = NULL;
+static SDL_sem *s_ntsc_start = NULL;
+static SDL_sem *s_ntsc_done = NULL;
+static volatile bool s_ntsc_quit;
+
+static void flip_Downscale_NTSC(uint16 *ntsc_px, SDL_Surface *dst_surface, const ScalePlan *plan, int first_row, int last_row);
+
+/**
+ * Filters and scales one row band of the current frame.
+ */
+static void NTSCBlitBand(int band) {
+	int src_first = band ? s_plan.band_src_row : 0;
+	int src_last = band ? s_plan.tlines : s_plan.band_src_row;
+	int dst_first = band ? s_plan.band_dst_row : 0;
+	int dst_last = band ? s_plan.dst_h : s_plan.band_dst_row;
+
+	dingoo_ntsc_blit16(s_ntsc, s_ntsc_src + (s_plan.srendline + src_first) * 256, 256,
+			(s_ntsc_burst + src_first) % nes_ntsc_burst_count, s_ntsc_emphasis,
+			256, src_last - src_first,
+			s_ntscbuf + src_first * DINGOO_NTSC_OUT_WIDTH,
+			DINGOO_NTSC_OUT_WIDTH * sizeof(uint16));
+
+	flip_Downscale_NTSC(s_ntscbuf, hw_screen, &s_plan, dst_first, dst_last);
+}
+
+static int NTSCThread(void *data) {
+	for (;;) {
+		SDL_SemWait(s_ntsc_start);
+		if (s_ntsc_quit)
+			break;
+		NTSCBlitBand(1);
+		SDL_SemPost(s_ntsc_done);
+	}
+	return 0;
+}
+
+/**
+ * Allocates the NTSC filter tables and starts the band thread. Called the
+ * first time the NTSC display mode is used. Returns 0 on success, -1 on
+ * failure. If the thread can not be started both bands run on the main
+ * thread.
+ */
+static int InitNTSC(void) {
+	if (s_ntsc)
+		return 0;
+
+	s_ntsc = (nes_ntsc_t *) FCEU_dmalloc(sizeof(nes_ntsc_t));
+	s_ntscbuf = (uint16 *) FCEU_dmalloc(DINGOO_NTSC_OUT_WIDTH * 240 * sizeof(uint16));
+	if (!s_ntsc || !s_ntscbuf) {
+		FCEU_dfree(s_ntsc);
+		FCEU_dfree(s_ntscbuf);
+		s_ntsc = NULL;
+		s_ntscbuf = NULL;
+		return -1;
+	}
+	nes_ntsc_init(s_ntsc, &nes_ntsc_composite, 2);
+
+	s_ntsc_quit = false;
+	s_ntsc_start = SDL_CreateSemaphore(0);
+	s_ntsc_done = SDL_CreateSemaphore(0);
+	if (s_ntsc_start && s_ntsc_done)
+		s_ntsc_thread = SDL_CreateThread(NTSCThread, NULL);
+	if (!s_ntsc_thread)
+		fprintf(stderr, "NTSC filter running single threaded: %s\n", SDL_GetError());
+
+	return 0;
+}
+
+static void KillNTSC(void) {
+	if (s_ntsc_thread) {
+		s_ntsc_quit = true;
+		SDL_SemPost(s_ntsc_start);
+		SDL_WaitThread(s_ntsc_thread, NULL);
+		s_ntsc_thread = NULL;
+	}
+	if (s_ntsc_start) {
+		SDL_DestroySemaphore(s_ntsc_start);
+		s_ntsc_start = NULL;
+	}
+	if (s_ntsc_done) {
+		SDL_DestroySemaphore(s_ntsc_done);
+		s_ntsc_done = NULL;
+	}
+
+	FCEU_dfree(s_ntsc);
+	FCEU_dfree(s_ntscbuf);
+	s_ntsc = NULL;
+	s_ntscbuf = NULL;
+}
+
+/**
+ * Runs the NTSC filter on XBuf and scales the result to the hw screen.
+ */
+static void BlitNTSC(uint8 *XBuf) {
+	s_ntsc_src = XBuf;
+	s_ntsc_emphasis = (PPU[1] >> 5) << 6;
+	s_ntsc_burst ^= 1;
+
+	if (s_ntsc_thread) {
+		SDL_SemPost(s_ntsc_start);
+		NTSCBlitBand(0);
+		SDL_SemWait(s_ntsc_done);
+	} else {
+		NTSCBlitBand(0);
+		NTSCBlitBand(1);
+	}
+}
+
+/**
+ * Direct rendering: with SDL.DirectRender the core hands every scanline
+ * to DirectLine() as soon as the PPU has finished it, and the line is
+ * scaled into hw_screen while it is still in cache. BlitScreen() then
+ * only has to flip, unless some lines did not come through the hook.
+ * hw_screen stays locked from the first line of a frame until the flip.
+ */
+static bool s_locked = false;
+static int s_direct_next = 0;	// next scanline expected from the PPU
+
+static void LockScreen(void) {
+	if (s_locked)
+		return;
+	if (SDL_MUSTLOCK(hw_screen)) SDL_LockSurface(hw_screen);
+	s_locked = true;
+}
+
+static void UnlockScreen(void) {
+	if (!s_locked)
+		return;
+	if (SDL_MUSTLOCK(hw_screen)) SDL_UnlockSurface(hw_screen);
+	s_locked = false;
+}
+
+static void flip_NNOptimized_Line_NES(uint8_t *row, SDL_Surface *dst_surface, const ScalePlan *plan, int i);
+
+static void DirectLine(int line, uint8 *row) {
+	if (!s_locked) {
+		/* first line of a new frame */
+		LockScreen();
+		if (UpdateScalePlan())
+			dingoo_clear_video();
+		s_direct_next = 0;
+	}
+
+	/* NTSC works on whole frames */
+	if (s_plan.aspect_ratio == ASPECT_RATIOS_TYPE_NTSC)
+		return;
+
+	if (line == s_direct_next)
+		s_direct_next++;
+
+	int r = line - s_plan.src_row_base;
+	if (r < 0 || r >= 256)
+		return;
+	for (int k = 0; k < s_plan.row_dst_count[r]; k++)
+		flip_NNOptimized_Line_NES(row + s_plan.src_col_offset, hw_screen, &s_plan, s_plan.row_dst_first[r] + k);
+}
+
 /**
  * Attempts to destroy the graphical video display.  Returns 0 on
  * success, -1 on failure.
@@ -106,9 +436,13 @@ int KillVideo() {
 	if (s_inited == 0)
 		return -1;
 
+	FCEUI_SetLineHook(NULL);
+	UnlockScreen();
+	HWOut_Kill();
+
 	deinit_menu_SDL();
 
-	TTF_Quit();
+	KillNTSC();
 
 	SDL_FreeSurface(nes_screen);
 	s_inited = 0;
@@ -126,11 +460,19 @@ inline double GetYScale(int yres) {
 }
 void FCEUD_VideoChanged() {
 	int buf;
-	g_config->getOption("SDL.PAL", &buf);
+	g_config->getOption(g_opts.pal, &buf);
 	if (buf)
 		PAL = 1;
 	else
 		PAL = 0;
+
+	// the rendered line range depends on the video system
+	if (s_inited) {
+		FCEUI_GetCurrentVidSystem(&s_srendline, &s_erendline);
+		s_tlines = s_erendline - s_srendline + 1;
+		/* rebuilt on the next frame, which also clears the old borders */
+		s_plan.valid = false;
+	}
 }
 /**
  * Attempts to initialize the graphical video display.  Returns 0 on
@@ -140,13 +482,18 @@ int InitVideo(FCEUGI *gi) {
 	FCEUI_printf("Initializing video...\n");
 
 	// load the relevant configuration variables
-	g_config->getOption("SDL.Fullscreen", &s_fullscreen);
-	g_config->getOption("SDL.ClipSides", &s_clipSides);
+	g_config->getOption(g_opts.fullscreen, &s_fullscreen);
+	g_config->getOption(g_opts.clipSides, &s_clipSides);
+	g_config->getOption(g_opts.blitBench, &s_blitbench);
+	g_config->getOption(g_opts.directRender, &s_directrender);
 
 	// check the starting, ending, and total scan lines
 	FCEUI_GetCurrentVidSystem(&s_srendline, &s_erendline);
 	s_tlines = s_erendline - s_srendline + 1;
 
+	s_plan.valid = false;
+	UpdateScalePlan();
+
 	int brightness;
 	g_config->getOption("SDL.Brightness", &brightness);
 
@@ -173,9 +520,16 @@ int InitVideo(FCEUGI *gi) {
 		s_VideoModeSet = true;
 	}
 
-	if (TTF_Init()) {
-		fprintf(stderr, "Error TTF_Init: %s\n", TTF_GetError());
-		exit(EXIT_FAILURE);
+	// Optional hardware scaled output, the SDL surfaces are kept for the menu.
+	// Nothing drawn with SDL shows while it is active, so it is only started
+	// for a game (not for the file browser), and every SDL screen on top of
+	// the game suspends it: see dingoo_video_suspend_hwout().
+	std::string backend, device;
+	g_config->getOption(g_opts.videoBackend, &backend);
+	g_config->getOption(g_opts.videoDevice, &device);
+	if (gi && (!strcasecmp(backend.c_str(), "fbdev") || !strcasecmp(backend.c_str(), "kms"))) {
+		if (HWOut_Init(strcasecmp(backend.c_str(), "kms") ? HWOUT_FBDEV : HWOUT_KMS, device.c_str()) < 0)
+			fprintf(stderr, "Video backend %s unavailable, using SDL\n", backend.c_str());
 	}
 
 	// a hack to bind inner buffer to nes_screen surface
@@ -191,8 +545,10 @@ int InitVideo(FCEUGI *gi) {
 	/* clear screen */
 	dingoo_clear_video();
 
+	// menu fonts and images are loaded when the menu is first opened
 
-	init_menu_SDL();
+	s_direct_next = 0;
+	FCEUI_SetLineHook(s_directrender && !HWOut_Active() ? DirectLine : NULL);
 
 	return 0;
 }
@@ -333,152 +689,178 @@ void flip_NNOptimized_AllowOutOfScreen(SDL_Surface *src_surface, SDL_Surface *ds
 	}
 }
 
-/// Nearest neighboor optimized with possible out of screen coordinates (for cropping)
-void flip_NNOptimized_AllowOutOfScreen_NES(uint8_t *nes_px, SDL_Surface *dst_surface, int new_w, int new_h) {
-	int w1 = 256; //NWIDTH;
-	int h1 = s_tlines;
-	int w2 = new_w;
-	int h2 = new_h;
-	int x_ratio = (int) ((w1 << 16) / w2);
-	int y_ratio = (int) ((h1 << 16) / h2);
-	int x2, y2;
+/// Nearest neighboor for destination row i, from the source line it maps to
+static void flip_NNOptimized_Line_NES(uint8_t *p, SDL_Surface *dst_surface, const ScalePlan *plan, int i) {
+	const uint16 *col_map = plan->col_map;
+	uint16_t *t = static_cast<uint16_t*>(dst_surface->pixels) + ((i + plan->y_padding) * plan->dst_pitch);
 
-	/// --- Compute padding for centering when out of bounds ---
-	int y_padding = (RES_HW_SCREEN_VERTICAL - new_h) / 2;
-	int x_padding = 0;
-	if (w2 > RES_HW_SCREEN_HORIZONTAL) {
-		x_padding = (w2 - RES_HW_SCREEN_HORIZONTAL) / 2 + 1;
-	}
-	int x_padding_ratio = x_padding * w1 / w2;
-	//printf("src_surface->h=%d, h2=%d\n", src_surface->h, h2);
-
-	for (int i = 0; i < h2; i++) {
-		if (i >= RES_HW_SCREEN_VERTICAL) {
-			continue;
-		}
-
-		uint16_t *t = static_cast<uint16_t*>(dst_surface->pixels) + ((i + y_padding) * ((w2 > RES_HW_SCREEN_HORIZONTAL) ? RES_HW_SCREEN_HORIZONTAL : w2));
-		y2 = (i * y_ratio) >> 16;
-		uint8_t *p = (uint8_t *) (nes_px + (y2 * w1 + x_padding_ratio) * sizeof (uint8_t));
-		int rat = 0;
-		for (int j = 0; j < w2; j++) {
-			if (j >= RES_HW_SCREEN_HORIZONTAL) {
-				continue;
-			}
-			x2 = rat>>16;
-			*t++ = s_psdl[p[x2]];
-			rat += x_ratio;
-			//printf("y=%d, x=%d, y2=%d, x2=%d, (y2*src_surface->w)+x2=%d\n", i, j, y2, x2, (y2 * src_surface->w) + x2);
-		}
+	for (int j = 0; j < plan->dst_w; j++) {
+		*t++ = s_psdl[p[col_map[j]]];
 	}
 }
 
-/// Nearest neighboor optimized with possible out of screen coordinates (for cropping)
-void flip_Downscale_LeftRightGaussianFilter_NES(uint8_t *nes_px, SDL_Surface *dst_surface, int new_w, int new_h) {
-	int w1 = 256; //NWIDTH;
-	int h1 = s_tlines;
-	int w2 = new_w;
-	int h2 = new_h;
-	int x_ratio = (int) ((w1 << 16) / w2);
-	int y_ratio = (int) ((h1 << 16) / h2);
-	int x1, y1;
-
-	/// --- Compute padding for centering when out of bounds ---
-	int y_padding = (RES_HW_SCREEN_VERTICAL - new_h) / 2;
-	int x_padding = 0;
-	if (w2 > RES_HW_SCREEN_HORIZONTAL) {
-		x_padding = (w2 - RES_HW_SCREEN_HORIZONTAL) / 2 + 1;
+/// Nearest neighboor using the precomputed scaling plan
+void flip_NNOptimized_AllowOutOfScreen_NES(uint8_t *nes_px, SDL_Surface *dst_surface, const ScalePlan *plan) {
+	for (int i = 0; i < plan->dst_h; i++) {
+		flip_NNOptimized_Line_NES(nes_px + plan->row_offset[i], dst_surface, plan, i);
 	}
-	int x_padding_ratio = x_padding * w1 / w2;
-	//printf("src_surface->h=%d, h2=%d\n", src_surface->h, h2);
+}
 
-	/// --- Interp params ---
-	int px_diff_prev_x = 0;
-	int px_diff_next_x = 0;
-	uint32_t ponderation_factor;
-	uint8_t left_px_missing, right_px_missing;
+/// Downscale with left/right gaussian blend, using the precomputed scaling plan
+void flip_Downscale_LeftRightGaussianFilter_NES(uint8_t *nes_px, SDL_Surface *dst_surface, const ScalePlan *plan) {
+	const uint16 *col_map = plan->col_map;
+	const uint8 *col_blend = plan->col_blend;
 
 	uint16_t *cur_p;
 	uint16_t *cur_p_left;
 	uint16_t *cur_p_right;
 	uint32_t red_comp, green_comp, blue_comp;
+	uint32_t ponderation_factor;
 
-	for (int i = 0; i < h2; i++) {
-		if (i >= RES_HW_SCREEN_VERTICAL) {
-			continue;
-		}
+	for (int i = 0; i < plan->dst_h; i++) {
+		uint16_t *t = static_cast<uint16_t*>(dst_surface->pixels) + ((i + plan->y_padding) * plan->dst_pitch);
+		uint8_t *p = nes_px + plan->row_offset[i];
+		for (int j = 0; j < plan->dst_w; j++) {
+			int x1 = col_map[j];
+			uint8 blend = col_blend[j];
 
-		uint16_t *t = static_cast<uint16_t*>(dst_surface->pixels) + ((i + y_padding) * ((w2 > RES_HW_SCREEN_HORIZONTAL) ? RES_HW_SCREEN_HORIZONTAL : w2));
-		y1 = (i * y_ratio) >> 16;
-		uint8_t *p = (uint8_t *) (nes_px + (y1 * w1 + x_padding_ratio) * sizeof (uint8_t));
-		int rat = 0;
-		for (int j = 0; j < w2; j++) {
-			if (j >= RES_HW_SCREEN_HORIZONTAL) {
+			if (!(blend & PLAN_BLEND)) {
+				*t++ = s_psdl[p[x1]];
 				continue;
 			}
 
-			// ------ current x value ------
-			x1 = rat >> 16;
-			px_diff_next_x = ((rat + x_ratio) >> 16) - x1;
-
 			// ------ adapted bilinear with 3x3 gaussian blur -------
 			cur_p = &s_psdl[*(p + x1)];
-			if (px_diff_prev_x > 1 || px_diff_next_x > 1 ) {
-				red_comp= ((*cur_p) & 0xF800) << 1;
-				green_comp = ((*cur_p) & 0x07E0) << 1;
-				blue_comp = ((*cur_p) & 0x001F) << 1;
-
-				left_px_missing = (px_diff_prev_x > 1 && x1 > 0);
-				right_px_missing = (px_diff_next_x > 1 && x1 + 1 < w1);
-				ponderation_factor = 2 + left_px_missing + right_px_missing;
-
-				// ---- Interpolate current and left ----
-				if (left_px_missing) {
-					cur_p_left = &s_psdl[*(p + x1 - 1)];
-					red_comp += ((*cur_p_left) & 0xF800);
-					green_comp += ((*cur_p_left) & 0x07E0);
-					blue_comp += ((*cur_p_left) & 0x001F);
-				}
-
-				// ---- Interpolate current and right ----
-				if (right_px_missing) {
-					cur_p_right = &s_psdl[*(p + x1 + 1)];
-					red_comp += ((*cur_p_right) & 0xF800);
-					green_comp += ((*cur_p_right) & 0x07E0);
-					blue_comp += ((*cur_p_right) & 0x001F);
-				}
-
-				/// --- Compute new px value ---
-				if (ponderation_factor == 4) {
-					red_comp = (red_comp >> 2) & 0xF800;
-					green_comp = (green_comp >> 2) & 0x07C0;
-					blue_comp = (blue_comp >> 2) & 0x001F;
-				} else if (ponderation_factor == 2) {
-					red_comp = (red_comp >> 1) & 0xF800;
-					green_comp = (green_comp >> 1) & 0x07C0;
-					blue_comp = (blue_comp >> 1) & 0x001F;
-				} else {
-					red_comp = (red_comp / ponderation_factor) & 0xF800;
-					green_comp = (green_comp / ponderation_factor) & 0x07C0;
-					blue_comp = (blue_comp / ponderation_factor) & 0x001F;
-				}
-
-				/// --- write pixel ---
-				*t++ = red_comp + green_comp + blue_comp;
+			red_comp = ((*cur_p) & 0xF800) << 1;
+			green_comp = ((*cur_p) & 0x07E0) << 1;
+			blue_comp = ((*cur_p) & 0x001F) << 1;
+			ponderation_factor = 2;
+
+			// ---- Interpolate current and left ----
+			if (blend & PLAN_BLEND_LEFT) {
+				cur_p_left = &s_psdl[*(p + x1 - 1)];
+				red_comp += ((*cur_p_left) & 0xF800);
+				green_comp += ((*cur_p_left) & 0x07E0);
+				blue_comp += ((*cur_p_left) & 0x001F);
+				ponderation_factor++;
+			}
+
+			// ---- Interpolate current and right ----
+			if (blend & PLAN_BLEND_RIGHT) {
+				cur_p_right = &s_psdl[*(p + x1 + 1)];
+				red_comp += ((*cur_p_right) & 0xF800);
+				green_comp += ((*cur_p_right) & 0x07E0);
+				blue_comp += ((*cur_p_right) & 0x001F);
+				ponderation_factor++;
+			}
+
+			/// --- Compute new px value ---
+			if (ponderation_factor == 4) {
+				red_comp = (red_comp >> 2) & 0xF800;
+				green_comp = (green_comp >> 2) & 0x07C0;
+				blue_comp = (blue_comp >> 2) & 0x001F;
+			} else if (ponderation_factor == 2) {
+				red_comp = (red_comp >> 1) & 0xF800;
+				green_comp = (green_comp >> 1) & 0x07C0;
+				blue_comp = (blue_comp >> 1) & 0x001F;
 			} else {
-			  *t++ = s_psdl[p[x1]];
+				red_comp = (red_comp / ponderation_factor) & 0xF800;
+				green_comp = (green_comp / ponderation_factor) & 0x07C0;
+				blue_comp = (blue_comp / ponderation_factor) & 0x001F;
 			}
 
-			/// save number of pixels to interpolate
-			px_diff_prev_x = px_diff_next_x;
+			/// --- write pixel ---
+			*t++ = red_comp + green_comp + blue_comp;
+		}
+	}
+}
 
-			// ------ next pixel ------
-			rat += x_ratio;
-			//printf("y=%d, x=%d, y2=%d, x2=%d, (y2*src_surface->w)+x2=%d\n", i, j, y2, x2, (y2 * src_surface->w) + x2);
+/// Downscale the nes_ntsc output with a 2-tap horizontal average, using the precomputed scaling plan
+static void flip_Downscale_NTSC(uint16 *ntsc_px, SDL_Surface *dst_surface, const ScalePlan *plan, int first_row, int last_row) {
+	const uint16 *col_map = plan->col_map;
+
+	for (int i = first_row; i < last_row; i++) {
+		uint16_t *t = static_cast<uint16_t*>(dst_surface->pixels) + ((i + plan->y_padding) * plan->dst_pitch);
+		uint16 *p = ntsc_px + plan->row_offset[i];
+		for (int j = 0; j < plan->dst_w; j++) {
+			uint16 a = p[col_map[j]];
+			uint16 b = p[col_map[j] + 1];
+			*t++ = ((a & 0xF7DE) >> 1) + ((b & 0xF7DE) >> 1);
 		}
 	}
 }
 
+/**
+ * Converts the native frame straight into the hardware output buffer,
+ * the display controller does the scaling.
+ */
+static void BlitHWOut(uint8 *XBuf) {
+	int pitch;
+	uint16 *dst = HWOut_BeginFrame(&pitch);
+
+	for (int y = s_srendline; y <= s_erendline; y++) {
+		uint8 *p = XBuf + y * 256;
+		uint16 *t = dst + y * pitch;
+		for (int x = NOFFSET; x < 256 - NOFFSET; x++)
+			t[x] = s_psdl[p[x]];
+	}
+
+	HWOut_EndFrame();
+}
+
+/**
+ * Hands the display back to SDL for the menu, with the current frame
+ * scaled into hw_screen so the menu has its usual background.
+ */
+void dingoo_video_suspend_hwout(void) {
+	extern uint8 *XBuf;
+
+	if (!HWOut_Active())
+		return;
+
+	HWOut_Suspend();
+	LockScreen();
+	UpdateScalePlan();
+	dingoo_clear_video();
+	flip_NNOptimized_AllowOutOfScreen_NES(XBuf, hw_screen, &s_plan);
+	UnlockScreen();
+}
+
+void dingoo_video_resume_hwout(void) {
+	HWOut_Resume();
+	if (!HWOut_Active()) {
+		/* the output could not be restored, go on with SDL */
+		FCEUI_SetLineHook(s_directrender ? DirectLine : NULL);
+	}
+}
+
+/**
+ * Accumulates the time spent in the blitter and prints the average every
+ * BLITBENCH_FRAMES frames, to compare display modes on the device.
+ */
+#define BLITBENCH_FRAMES	300
+
+static void BlitBench(unsigned int mode, const struct timespec *start) {
+	static unsigned int bench_mode = NB_ASPECT_RATIOS_TYPES;
+	static long bench_us = 0;
+	static int bench_frames = 0;
+	struct timespec end;
+
+	clock_gettime(CLOCK_MONOTONIC, &end);
+	if (mode != bench_mode) {
+		bench_mode = mode;
+		bench_us = 0;
+		bench_frames = 0;
+	}
+
+	bench_us += (end.tv_sec - start->tv_sec) * 1000000L + (end.tv_nsec - start->tv_nsec) / 1000L;
+	if (++bench_frames == BLITBENCH_FRAMES) {
+		printf("Blit %s: %ld us/frame\n", aspect_ratio_name[mode], bench_us / bench_frames);
+		bench_us = 0;
+		bench_frames = 0;
+	}
+}
+
 /**
  * Pushes the given buffer of bits to the screen.
  */
@@ -513,41 +895,34 @@ void BlitScreen(uint8 *XBuf) {
 	}
 
 	// TODO - Move these to its own file?
-	if (SDL_MUSTLOCK(hw_screen)) SDL_LockSurface(hw_screen);
-
-	register uint8 *pBuf = XBuf;
-
-	static int prev_aspect_ratio = aspect_ratio;
+	LockScreen();
 
 	/* Clear screen if AR changed */
-	if (prev_aspect_ratio != aspect_ratio) {
-		prev_aspect_ratio = aspect_ratio;
+	if (UpdateScalePlan()) {
 		dingoo_clear_video();
+		s_direct_next = 0;
 	}
 
 	//printf("s_tlines = %d, s_srendline=%d, NOFFSET = %d, NWIDTH=%d\n", s_tlines, s_srendline, NOFFSET, NWIDTH);
-	
-	switch (aspect_ratio) {
-		case ASPECT_RATIOS_TYPE_STRETCHED: 
-		/* Stretched NN*/
-		flip_NNOptimized_AllowOutOfScreen_NES(pBuf, hw_screen, hw_screen->w, hw_screen->h);
-		break;
 
-		case ASPECT_RATIOS_TYPE_CROPPED:
-		/* Cropped but not centered yes for some games */
-		pBuf += (s_srendline * 256) + NOFFSET;
-		flip_NNOptimized_AllowOutOfScreen_NES(pBuf, hw_screen, NWIDTH, s_tlines);
-		break;
+	struct timespec bench_start;
+	if (s_blitbench)
+		clock_gettime(CLOCK_MONOTONIC, &bench_start);
 
-		default:
-		aspect_ratio = ASPECT_RATIOS_TYPE_CROPPED;
-		/* Cropped NN*/
-		flip_NNOptimized_AllowOutOfScreen_NES(pBuf, hw_screen, NWIDTH, s_tlines);
-		break;
-	}
+	if (HWOut_Active())
+		BlitHWOut(XBuf);
+	else if (s_plan.aspect_ratio == ASPECT_RATIOS_TYPE_NTSC && InitNTSC() == 0)
+		BlitNTSC(XBuf);
+	else if (s_direct_next != 240)	// not every line went through DirectLine()
+		flip_NNOptimized_AllowOutOfScreen_NES(XBuf, hw_screen, &s_plan);
+	s_direct_next = 0;
 
-	if (SDL_MUSTLOCK(hw_screen)) SDL_UnlockSurface(hw_screen);
-	SDL_Flip(hw_screen);
+	if (s_blitbench)
+		BlitBench(s_plan.aspect_ratio, &bench_start);
+
+	UnlockScreen();
+	if (!HWOut_Active())
+		SDL_Flip(hw_screen);
 }
 
 /**
@@ -12,5 +12,7 @@ unsigned short *FCEUD_GetScreen();
 #define dingoo_video_color15(R,G,B) ((((R)&0xF8)<<8)|(((G)&0xFC)<<3)|(((B)&0xF8)>>3))
 
 extern void dingoo_clear_video(void);
+extern void dingoo_video_suspend_hwout(void);
+extern void dingoo_video_resume_hwout(void);
 
 #endif // __DINGOO_VIDEO__
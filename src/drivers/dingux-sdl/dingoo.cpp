@@ -35,6 +35,7 @@
 #include "SDL/SDL.h"
 #include "dingoo.h"
 #include "dingoo-video.h"
+#include "dingoo-resume.h"
 #include "dummy-netplay.h"
 
 #include "../common/configSys.h"
@@ -99,11 +100,14 @@ bool   paldeemphswap   = 0;
 
 char *load_state_file = NULL;
 std::string load_state_file_string;
+static std::string resume_file_string;
 static char *prog_name;
 char *mRomName = NULL;
 char *mRomPath = NULL;
 static char *quick_save_file_extension = "quicksave";
 char *quick_save_file = NULL;
+static char *resume_file_extension = "resume";
+static char *resume_file = NULL;
 char *cfg_file_default = NULL;
 char *cfg_file_rom = NULL;
 static char *cfg_file_default_name = "default_config";
@@ -131,6 +135,20 @@ char* DriverUsage = "\
 		--noframe      {0|1}   Hide title bar and window decorations.\n\
 		--special      {1-4}   Use special video scaling filters\n\
 		(1 = hq2x 2 = Scale2x 3 = hq3x 4 = Scale3x)\n\
+		--blitbench    {0|1}   Print the average time spent blitting each frame.\n\
+		--directrender {0|1}   Scale each scanline to the screen as soon as it is rendered.\n\
+		--videobackend {sdl|fbdev|kms} Let the display hardware scale the native frame.\n\
+		--videodevice  d       Framebuffer or DRM device for --videobackend.\n\
+		--statebackbuf {0|1|2} Back buffer in savestates: 0 omit, 1 raw, 2 compressed.\n\
+		--statecodec   {0|1}   Savestate compression: 0 zlib, 1 fast LZ.\n\
+		--statethumb   {0|1}   Store a preview picture in savestates.\n\
+		--rewind       x       Keep a rewind snapshot every x frames (0 = off).\n\
+		--rewindbuf    x       Memory for rewind snapshots in MB.\n\
+		--runahead     x       Show the picture x frames ahead to cut input lag (0 = off).\n\
+		--runaheadsecond {0|1} Run ahead without touching the sound mixer.\n\
+		--moviecache   x       Cache a state every x movie frames for seeking (0 = off).\n\
+		--moviecachebuf x      Memory for cached movie states in MB.\n\
+		--tracestartup {0|1}   Print how long each startup step took.\n\
 		--palette      f       Load custom global palette from file f.\n\
 		--sound        {0|1}   Enable sound.\n\
 		--soundrate	   x       Set sound playback rate to x Hz.\n\
@@ -204,6 +222,41 @@ void FCEUD_Message(char *s) {
 	fputs(s, stdout);
 }
 
+// Startup timeline: when each step of a cold launch finished, collected until
+// the first frame is out and printed then if SDL.StartupTrace is set.
+#define STARTUP_MARKS 32
+static struct {
+	const char *what;
+	long long us;
+} startupMarks[STARTUP_MARKS];
+static int startupMarkCount = 0;
+static bool startupDone = false;
+
+void StartupMark(const char *what) {
+	if (startupDone || startupMarkCount == STARTUP_MARKS)
+		return;
+	namespace sc = std::chrono;
+	startupMarks[startupMarkCount].what = what;
+	startupMarks[startupMarkCount].us = sc::duration_cast<sc::microseconds>(
+		sc::steady_clock::now().time_since_epoch()).count();
+	startupMarkCount++;
+}
+
+static void StartupReport(void) {
+	int trace;
+	startupDone = true;
+	g_config->getOption("SDL.StartupTrace", &trace);
+	if (!trace || !startupMarkCount)
+		return;
+	printf("Startup timeline (ms since start, ms for the step):\n");
+	for (int i = 0; i < startupMarkCount; i++) {
+		long long prev = startupMarks[i ? i - 1 : 0].us;
+		printf("  %8.1f  %+8.1f  %s\n",
+			(startupMarks[i].us - startupMarks[0].us) / 1000.0,
+			(startupMarks[i].us - prev) / 1000.0, startupMarks[i].what);
+	}
+}
+
 /**
  * Loads a game, given a full path/filename.  The driver code must be
  * initialized after the game is loaded, because the emulator code
@@ -215,44 +268,47 @@ int LoadGame(const char *path) {
 	if (!FCEUI_LoadGame(path, 1)) {
 		return 0;
 	}
+	StartupMark("FCEUI_LoadGame");
 	ParseGIInput(GameInfo);
 	RefreshThrottleFPS();
 
 	// Reload game config or default config
 	g_config->reload(FCEU_MakeFName(FCEUMKF_CFG, 0, 0));
+	StartupMark("game config");
 
 #ifdef FRAMESKIP
 	// Update frameskip value
-	g_config->getOption("SDL.Frameskip", &frameskip);
+	g_config->getOption(g_opts.frameskip, &frameskip);
 #endif
 
 	if (!DriverInitialize(GameInfo)) {
 		return (0);
 	}
+	StartupMark("DriverInitialize");
 
 	// set pal/ntsc
 	int id;
-	g_config->getOption("SDL.PAL", &id);
+	g_config->getOption(g_opts.pal, &id);
 	if (id)
 		FCEUI_SetVidSystem(1);
 	else
 		FCEUI_SetVidSystem(0);
 
 	std::string filename;
-	g_config->getOption("SDL.Sound.RecordFile", &filename);
+	g_config->getOption(g_opts.soundRecordFile, &filename);
 	if (filename.size()) {
 		if (!FCEUI_BeginWaveRecord(filename.c_str())) {
-			g_config->setOption("SDL.Sound.RecordFile", "");
+			g_config->setOption(g_opts.soundRecordFile, "");
 		}
 	}
 
 	// Set mouse cursor's movement speed
-	g_config->getOption("SDL.MouseSpeed", &mousespeed);
-	g_config->getOption("SDL.ShowMouseCursor", &showmouse);
+	g_config->getOption(g_opts.mouseSpeed, &mousespeed);
+	g_config->getOption(g_opts.showMouseCursor, &showmouse);
 
 	// Show or not to show fps, that is the cuestion ...
-	g_config->getOption("SDL.ShowFPS", &showfps);
-	g_config->getOption("SDL.FPSThrottle", &fpsthrottle);
+	g_config->getOption(g_opts.showFPS, &showfps);
+	g_config->getOption(g_opts.fpsThrottle, &fpsthrottle);
 
 	isloaded = 1;
 
@@ -275,7 +331,7 @@ int CloseGame() {
 	isloaded = 0;
 	GameInfo = 0;
 
-	g_config->getOption("SDL.Sound.RecordFile", &filename);
+	g_config->getOption(g_opts.soundRecordFile, &filename);
 	if (filename.size()) {
 		FCEUI_EndWaveRecord();
 	}
@@ -313,12 +369,28 @@ void quick_save_and_poweroff()
 		exit(0);
 	}
 
-	/* Save  */
-	FCEUI_SaveState(quick_save_file);
+	/* Save: the snapshot is taken right away, the file is written in the
+	   background and replaced atomically; wait for it to reach the disk */
+	FCEUI_SaveStateAsync(quick_save_file);
+
+	/* Resume image for a fast boot, written while the quick save is */
+	bool resume = Resume_Save(resume_file);
+	if (!resume) {
+		printf("Failed to write %s\n", resume_file);
+		remove(resume_file);
+	}
+
+	if (!FCEUI_WaitStateSaves())
+		printf("Failed to write %s\n", quick_save_file);
 
 	/* Perform Instant Play save and shutdown */
-	execlp(SHELL_CMD_INSTANT_PLAY, SHELL_CMD_INSTANT_PLAY,
-	       prog_name, "--loadStateFile", quick_save_file, mRomName, NULL);
+	if (resume)
+		execlp(SHELL_CMD_INSTANT_PLAY, SHELL_CMD_INSTANT_PLAY,
+		       prog_name, "--resumeFile", resume_file,
+		       "--loadStateFile", quick_save_file, mRomName, NULL);
+	else
+		execlp(SHELL_CMD_INSTANT_PLAY, SHELL_CMD_INSTANT_PLAY,
+		       prog_name, "--loadStateFile", quick_save_file, mRomName, NULL);
 
 	/* Should not be reached */
 	printf("Failed to perform Instant Play save and shutdown\n");
@@ -346,6 +418,11 @@ static void DoFun(int fskip) {
     FCEUI_Emulate(&gfx, &sound, &ssize, 0);
     FCEUD_Update(gfx, sound, ssize);
 
+    if (!startupDone) {
+      StartupMark("first frame");
+      StartupReport();
+    }
+
     time_stamp e = sc::time_point_cast<sc::microseconds>(sc::steady_clock::now());
 
     auto delta = e - s;
@@ -392,7 +469,7 @@ int FCEUD_DriverReset() {
 
 #ifdef FRAMESKIP
 	// Update frameskip value
-	g_config->getOption("SDL.Frameskip", &frameskip);
+	g_config->getOption(g_opts.frameskip, &frameskip);
 #endif
 
 	// Kill drivers first
@@ -409,12 +486,12 @@ int FCEUD_DriverReset() {
 		inited |= 1;
 
 	// Set mouse cursor's movement speed
-	g_config->getOption("SDL.MouseSpeed", &mousespeed);
-	g_config->getOption("SDL.ShowMouseCursor", &showmouse);
+	g_config->getOption(g_opts.mouseSpeed, &mousespeed);
+	g_config->getOption(g_opts.showMouseCursor, &showmouse);
 
 	// Set showfps variable and throttle
-	g_config->getOption("SDL.ShowFPS", &showfps);
-	g_config->getOption("SDL.FPSThrottle", &fpsthrottle);
+	g_config->getOption(g_opts.showFPS, &showfps);
+	g_config->getOption(g_opts.fpsThrottle, &fpsthrottle);
 
 	return 1;
 }
@@ -587,7 +664,9 @@ int FCEUD_LoadMovie(const char *name, char *romname) {
 int main(int argc, char *argv[]) {
 
 	int error;
+	bool resumed = false;
 
+	StartupMark("start");
 	FCEUD_Message("\nStarting "FCEU_NAME_AND_VERSION"...\n");
 
 	/* Init Signals */
@@ -606,6 +685,7 @@ int main(int argc, char *argv[]) {
 		printf("Could not initialize SDL: %s.\n", SDL_GetError());
 		return(-1);
 	}
+	StartupMark("SDL_Init");
 
 	// Initialize the configuration system
 	g_config = InitConfig();
@@ -614,9 +694,10 @@ int main(int argc, char *argv[]) {
 		SDL_Quit();
 		return -1;
 	}
+	StartupMark("InitConfig");
 
-	// Initialize the fceu320 gui
-	FCEUGUI_Init(NULL);
+	// the fceu320 gui is only needed by the file browser, which sets it up
+	// itself when it is first run
 
 	// initialize the infrastructure
 	error = FCEUI_Initialize();
@@ -626,15 +707,18 @@ int main(int argc, char *argv[]) {
 		SDL_Quit();
 		return -1;
 	}
+	StartupMark("FCEUI_Initialize");
 
 	/* Load config from file */
 	g_config->load();
 
 	/* Overwrite load file */
 	g_config->setOption("SDL.loadStateFile", "");
+	g_config->setOption("SDL.ResumeFile", "");
 
 	/* Parse args */
 	int romIndex = g_config->parse(argc, argv);
+	StartupMark("config load and parse");
 	printf("romIndex = %d\n", romIndex);
 	if (romIndex < 0) {
 		printf("ERROR romIndex = %d, no ROM specified\n", romIndex);
@@ -647,6 +731,7 @@ int main(int argc, char *argv[]) {
 	if (strcmp(load_state_file_string.c_str(), "")) {
 		printf("************ load_state_file: %s\n", load_state_file_string.c_str());
 	}
+	g_config->getOption("SDL.ResumeFile", &resume_file_string);
 
 	/* Get rom names, directory and quick save file */
 	prog_name = argv[0];
@@ -669,6 +754,11 @@ int main(int argc, char *argv[]) {
 		sprintf(quick_save_file, "%s/%s.%s",
 			mRomPath, slash+1, quick_save_file_extension);
 		printf("************ quick_save_file: %s\n", quick_save_file);
+
+		/* Set Instant Play resume image filename */
+		resume_file = (char*) malloc(strlen(mRomPath) + strlen(slash+1) + strlen(resume_file_extension) + 2 + 1);
+		sprintf(resume_file, "%s/%s.%s",
+			mRomPath, slash+1, resume_file_extension);
 		printf("************ mRomPath: %s\n", mRomPath);
 		printf("************ mRomName: %s\n", mRomName);
 
@@ -689,6 +779,7 @@ int main(int argc, char *argv[]) {
         /** Load config files */
         configfile_load(cfg_file_default);
         configfile_load(cfg_file_rom);
+        StartupMark("configfile_load");
 
 		fclose(f);
 	} else {
@@ -865,6 +956,27 @@ int main(int argc, char *argv[]) {
 		g_config->getOption("SDL.SubtitleDisplay", &id);
 		extern bool movieSubtitles;
 		movieSubtitles = id;
+		g_config->getOption("SDL.StateBackBuffer", &id);
+		extern int backBufferSavestates;
+		backBufferSavestates = id;
+		g_config->getOption("SDL.StateCodec", &id);
+		extern int savestateCodec;
+		savestateCodec = id;
+		g_config->getOption("SDL.StateThumbnail", &id);
+		extern bool thumbnailSavestates;
+		thumbnailSavestates = id;
+		g_config->getOption("SDL.Rewind", &id);
+		int rewindbuf;
+		g_config->getOption("SDL.RewindBuffer", &rewindbuf);
+		FCEUI_SetRewind(id, rewindbuf << 20);
+		g_config->getOption("SDL.RunAhead", &id);
+		int runaheadsecond;
+		g_config->getOption("SDL.RunAheadSecondInstance", &runaheadsecond);
+		FCEUI_SetRunAhead(id, runaheadsecond != 0);
+		g_config->getOption("SDL.MovieCache", &id);
+		int moviecachebuf;
+		g_config->getOption("SDL.MovieCacheBuffer", &moviecachebuf);
+		FCEUI_SetMovieCache(id, moviecachebuf << 20);
 	}
 
 	// load the hotkeys from the config life
@@ -879,6 +991,18 @@ int main(int argc, char *argv[]) {
 			SDL_Quit();
 			return -1;
 		}
+		StartupMark("LoadGame");
+
+		/* Instant Play: the saved picture goes up and the game continues
+		   from the resume image; the quick save is the fallback */
+		if (resume_file_string.size()) {
+			if (Resume_Load(resume_file_string.c_str())) {
+				printf("Resumed from %s\n", resume_file_string.c_str());
+				resumed = true;
+			} else
+				printf("Cannot resume from %s\n", resume_file_string.c_str());
+			StartupMark("resume image");
+		}
 	} else {
 		// Launch file browser
 		const char *types[] = { ".nes", ".fds", ".zip", ".fcm", ".fm2", ".nsf",
@@ -937,11 +1061,13 @@ int main(int argc, char *argv[]) {
 			newppu = 1;
 	}
 
-	g_config->getOption("SDL.Frameskip", &frameskip);
+	g_config->getOption(g_opts.frameskip, &frameskip);
 
     // update rom specified input config
 	UpdateInput(g_config);
-	if (strcmp(load_state_file_string.c_str(), "") ) {
+	if (resumed) {
+		/* Already running from the resume image */
+	} else if (strcmp(load_state_file_string.c_str(), "") ) {
 
 		/* Load file */
 		printf("LOADING FROM FILE %s...\n", load_state_file_string.c_str());
@@ -953,7 +1079,9 @@ int main(int argc, char *argv[]) {
 		/* Load quick save file */
 		printf("Found quick save file: %s\n", quick_save_file);
 
+		dingoo_video_suspend_hwout();
 		int resume = launch_resume_menu_loop();
+		dingoo_video_resume_hwout();
 		if(resume == RESUME_YES){
 			printf("Resume game from quick save file: %s\n", quick_save_file);
 			FCEUI_LoadState(quick_save_file);
@@ -967,6 +1095,7 @@ int main(int argc, char *argv[]) {
 				printf("Unable to delete the file: %s\n", quick_save_file);
 			}
 		}
+		StartupMark("resume menu");
 	}
 
 	// loop playing the game
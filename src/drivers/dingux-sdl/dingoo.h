@@ -12,6 +12,7 @@ int LoadGame(const char *path);
 int CloseGame(void);
 
 int FCEUD_LoadMovie(const char *name, char *romname);
+void StartupMark(const char *what);
 int FCEUD_DriverReset();
 void quick_save_and_poweroff();
 
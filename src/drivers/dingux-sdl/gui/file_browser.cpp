@@ -23,6 +23,8 @@ int RunFileBrowser(char *source, char *outname, const char *types[],
 	static int spy;
 	int y, i;
 
+	FCEUGUI_Init(NULL);
+
 	// Try to get a saved romdir from a config file
 	char* home = getenv("HOME");
 	char romcfgfile [128];
@@ -5,14 +5,25 @@
 #include <stdio.h>
 #include <string.h>
 #include <stdlib.h>
+#include <time.h>
 #include <dirent.h>
 #include <sys/types.h>
 #include <sys/stat.h>
+#include <algorithm>
 #include <vector>
 
 #include "file_list.h"
-
-#define MAX_FILE_NAME 128
+#include "../../../utils/asyncio.h"
+
+// Each directory listing is cached in ~/.fceux/dirindex, already classified
+// and sorted, and reused for as long as the directory's mtime is unchanged.
+// Entries are classified by d_type, so listing a directory doesn't stat() its
+// files. Index file format:
+//   FCEUDIRINDEX 1
+//   <directory mtime> <entry count>
+//   <directory path>
+//   d <folder name> | f <file name>, one per line in display order
+#define DIRINDEX_MAGIC "FCEUDIRINDEX 1"
 
 using namespace std;
 
@@ -31,8 +42,118 @@ int is_ext(const char *s, const char *ext) {
 	return sext && strcasecmp(ext, sext) == 0;
 }
 
-int compare(const void* a, const void* b) {
-	return strcasecmp((const char *) a, (const char *) b);
+// Folders first, then files, each in case insensitive order
+static bool compare(const FileData &a, const FileData &b) {
+	if ((a.size == -1) != (b.size == -1))
+		return a.size == -1;
+	return strcasecmp(a.name.c_str(), b.name.c_str()) < 0;
+}
+
+static string JoinPath(const char *dirname, const char *name) {
+	string path(dirname);
+	if (path.empty() || path[path.size() - 1] != SEPARATOR)
+		path += SEPARATOR;
+	return path + name;
+}
+
+static string DirIndexPath(const char *dirname) {
+	const char *home = getenv("HOME");
+	if (!home)
+		return string();
+
+	// FNV-1a of the directory path
+	unsigned int hash = 2166136261u;
+	for (const char *p = dirname; *p; p++)
+		hash = (hash ^ (unsigned char)*p) * 16777619u;
+
+	char name[32];
+	sprintf(name, "%08x.idx", hash);
+	return string(home) + "/.fceux/dirindex/" + name;
+}
+
+static bool LoadDirIndex(const char *dirname, time_t mtime, vector<FileData> &entries) {
+	string fn = DirIndexPath(dirname);
+	FILE *fp = fn.empty() ? NULL : fopen(fn.c_str(), "rb");
+	if (!fp)
+		return false;
+
+	char line[512];
+	long stamp = 0;
+	int count = 0;
+	bool ok = fgets(line, sizeof(line), fp) && !strcmp(line, DIRINDEX_MAGIC "\n")
+		&& fgets(line, sizeof(line), fp) && sscanf(line, "%ld %d", &stamp, &count) == 2
+		&& stamp == (long)mtime && count >= 0
+		&& fgets(line, sizeof(line), fp) && !strncmp(line, dirname, strlen(dirname))
+		&& !strcmp(line + strlen(dirname), "\n");
+
+	if (ok)
+		entries.reserve(count);
+	for (int i = 0; ok && i < count; i++) {
+		size_t len;
+		ok = fgets(line, sizeof(line), fp) && (len = strlen(line)) > 3
+			&& line[len - 1] == '\n' && (line[0] == 'd' || line[0] == 'f') && line[1] == ' ';
+		if (ok) {
+			FileData fd;
+			fd.name.assign(line + 2, len - 3);
+			fd.size = line[0] == 'd' ? -1 : 0;
+			entries.push_back(fd);
+		}
+	}
+	fclose(fp);
+
+	if (!ok)
+		entries.clear();
+	return ok;
+}
+
+static void SaveDirIndex(const char *dirname, time_t mtime, const vector<FileData> &entries) {
+	string fn = DirIndexPath(dirname);
+	if (fn.empty())
+		return;
+
+	char head[64];
+	sprintf(head, "%ld %d\n", (long)mtime, (int)entries.size());
+	string data = string(DIRINDEX_MAGIC "\n") + head + dirname + "\n";
+	for (size_t i = 0; i < entries.size(); i++) {
+		data += entries[i].size == -1 ? "d " : "f ";
+		data += entries[i].name;
+		data += '\n';
+	}
+
+	string dir = fn.substr(0, fn.rfind('/'));
+	mkdir(dir.substr(0, dir.rfind('/')).c_str(), 0755);
+	mkdir(dir.c_str(), 0755);
+	FCEU_WriteFileAtomic(fn.c_str(), data.data(), data.size());
+}
+
+static bool ScanDirectory(const char *dirname, vector<FileData> &entries) {
+	DIR *dir = opendir(dirname);
+	if (!dir)
+		return false;
+
+	for (struct dirent *de; (de = readdir(dir));) {
+		// hidden entries are skipped, as are names the index can't hold
+		if (de->d_name[0] == '.' || strchr(de->d_name, '\n'))
+			continue;
+
+		int type = de->d_type;
+		if (type == DT_UNKNOWN || type == DT_LNK) {
+			// the filesystem doesn't tell, or it's a link to follow
+			struct stat ss;
+			if (stat(JoinPath(dirname, de->d_name).c_str(), &ss) != 0)
+				continue;
+			type = S_ISDIR(ss.st_mode) ? DT_DIR : DT_REG;
+		}
+
+		FileData fd;
+		fd.name = de->d_name;
+		fd.size = type == DT_DIR ? -1 : 0;
+		entries.push_back(fd);
+	}
+	closedir(dir);
+
+	sort(entries.begin(), entries.end(), compare);
+	return true;
 }
 
 /* Class functions */
@@ -47,71 +168,37 @@ FileList::FileList(char *dirname, const char *types[]) {
 	file_types = types;
 
 	if (dirname) {
-		strcpy(curdir, dirname);
-		Enter(dirname);
+		strncpy(curdir, dirname, sizeof(curdir) - 1);
+		curdir[sizeof(curdir) - 1] = 0;
+		Enter(curdir);
 	} else
 		*curdir = 0;
 }
 
-void FileList::AddDirectory(char *dirname, bool recursive) {
-	DIR *dir = opendir(dirname);
-	if (dir) {
-		char tmp[MAX_FILE_NAME];
-		int count = 0;
-		int folders = 0, files = 0;
-		for (struct dirent *de; de = readdir(dir);) {
-			struct stat ss;
-			ss.st_mode = 0;
-			sprintf(tmp, "%s%c%s", dirname, SEPARATOR, de->d_name);
-			if (stat(tmp, &ss) == 0 && de->d_name[0] != '.') {
-				if (ss.st_mode & S_IFDIR)
-					folders++;
-				else
-					files++;
-			}
-		}
-		rewinddir(dir);
-		char sorted[folders + files][MAX_FILE_NAME];
-		int k = 0, m = 0, n = 0;
-		for (struct dirent *de; de = readdir(dir);) {
-			struct stat ss;
-			ss.st_mode = 0;
-			sprintf(tmp, "%s%c%s", dirname, SEPARATOR, de->d_name);
-			if (stat(tmp, &ss) == 0 && de->d_name[0] != '.') {
-				if (ss.st_mode & S_IFDIR)
-					strcpy(sorted[k++], de->d_name);
-				else
-					strcpy(sorted[folders + n++], de->d_name);
-			}
-		}
-
-		qsort(sorted, folders, MAX_FILE_NAME, &compare);
-		qsort(&sorted[folders], files, MAX_FILE_NAME, &compare);
+const char *FileList::GetPath(int index) {
+	curpath = JoinPath(curdir, filerefs[index].name.c_str());
+	return curpath.c_str();
+}
 
-		for (k = 0, m = folders + files; k < m; k++) {
-			char *tmp2 = sorted[k];
-			struct stat ss;
-			ss.st_mode = 0;
-			sprintf(tmp, "%s%c%s", dirname, SEPARATOR, tmp2);
-			if (stat(tmp, &ss) == 0) {
-				if ((ss.st_mode & S_IFDIR) || filter_cb(tmp2)) {
-					if (recursive && (ss.st_mode & S_IFDIR))
-						AddDirectory(tmp, recursive);
-					else {
-						FileData fd;
-						fd.path = string(tmp);
-						fd.name = string(BaseName(tmp));
-						if (ss.st_mode & S_IFDIR)
-							fd.size = -1;
-						else
-							fd.size = ss.st_size;
-						filerefs.push_back(fd);
-					}
-				}
-			}
-		}
-		closedir(dir);
+void FileList::AddDirectory(char *dirname) {
+	struct stat ds;
+	if (stat(dirname, &ds) != 0 || !S_ISDIR(ds.st_mode))
+		return;
+
+	vector<FileData> entries;
+	if (!LoadDirIndex(dirname, ds.st_mtime, entries)) {
+		if (!ScanDirectory(dirname, entries))
+			return;
+		// a change later in the same second wouldn't move the mtime, so
+		// only listings of directories that have settled are indexed
+		if (time(NULL) > ds.st_mtime + 1)
+			SaveDirIndex(dirname, ds.st_mtime, entries);
 	}
+
+	filerefs.reserve(entries.size());
+	for (size_t i = 0; i < entries.size(); i++)
+		if (entries[i].size == -1 || filter_cb(entries[i].name.c_str()))
+			filerefs.push_back(entries[i]);
 }
 
 void FileList::Enter(char *dirname) {
@@ -120,25 +207,28 @@ void FileList::Enter(char *dirname) {
 }
 
 int FileList::Enter(int index) {
-	char old[MAX_FILE_NAME] = "";
+	char old[256] = "";
 	if (index == -1) {
 		char *end = strrchr(curdir, SEPARATOR);
 		if (end) {
-			strcpy(old, curdir);
+			strcpy(old, end + 1);
 			*end = 0;
 			if (!strchr(curdir, SEPARATOR)) {
 				*end = SEPARATOR;
 				end[1] = 0;
 			}
 		}
-	} else
-		strcpy(curdir, filerefs[index].path.c_str());
+	} else {
+		strncpy(curdir, GetPath(index), sizeof(curdir) - 1);
+		curdir[sizeof(curdir) - 1] = 0;
+	}
 
 	Enter(curdir);
 
+	// select the folder we came out of
 	if (strlen(old)) {
 		for (unsigned int i = 0; i < filerefs.size(); i++) {
-			if (strcmp(filerefs[i].path.c_str(), old) == 0) {
+			if (strcmp(filerefs[i].name.c_str(), old) == 0) {
 				return i;
 			}
 		}
@@ -147,4 +237,3 @@ int FileList::Enter(int index) {
 	return 0;
 
 }
-
@@ -5,6 +5,7 @@
 #ifndef FILELIST_H
 #define FILELIST_H
 
+#include <string>
 #include "files.h"
 
 class FileList : public IFileList
@@ -14,20 +15,21 @@ class FileList : public IFileList
         virtual ~FileList() {}
 
         virtual const char *GetName(int index)  { return filerefs[index].name.c_str(); }
-        virtual const char *GetPath(int index)  { return filerefs[index].path.c_str(); }
+        virtual const char *GetPath(int index);
         virtual int         GetSize(int index)  { return filerefs[index].size; }
         int                 Size()              { return filerefs.size(); }
         virtual int Enter(int index);
         char *GetCurDir() { return curdir; }
 
     protected:
-        void AddDirectory(char *dirname, bool recursive = false);
+        void AddDirectory(char *dirname);
         void Enter(char *dirname);
         int filter_cb(const char *);
       //  void *cb_data;
       //  bool dirty;
       //  int changed;
         char curdir[256];
+        std::string curpath;    // last GetPath result
         const char **file_types;
 };
 
@@ -13,8 +13,7 @@
 struct FileData
 {
     std::string name;
-    std::string path;
-    int size;
+    int size;       // -1 for folders
 };
 
 class IFileList
@@ -16,6 +16,7 @@
 extern SDL_Surface* screen;
 extern int RunFileBrowser(char *source, char *romname, const char *types[],
 		const char *info = NULL);
+int FCEUGUI_Init(FCEUGI *gi);
 
 typedef struct _menu_entry {
 	const char *name;
@@ -268,7 +269,7 @@ static int cmd_exit() {
 
 /* MAIN MENU */
 
-static MenuEntry main_menu[] = { 
+static const MenuEntry main_menu_all[] = { 
 		{ "Load state", "Load emulation state", load_state },
 		{ "Save state", "Save current state", save_state },
 		{ "Screenshot", "Save current frame shot", save_screenshot },
@@ -280,6 +281,7 @@ static MenuEntry main_menu[] = {
 		{ "Settings", "Change current settings", cmd_settings_menu },
 		{ "Exit", "Exit emulator", cmd_exit } 
 };
+static MenuEntry main_menu[sizeof(main_menu_all) / sizeof(main_menu_all[0])];
 static int main_menu_items;
 
 // #ifdef NO_ROM_BROWSER
@@ -291,26 +293,24 @@ static int main_menu_items;
 
 extern char FileBase[2048];
 
+static int inited = 0;
+
 int FCEUGUI_Init(FCEUGI *gi) 
 {
+	// every screen of the gui calls this first; load things only once
+	if (!inited) {
+		// create 565 RGB surface
+		gui_screen = SDL_CreateRGBSurface(SDL_SWSURFACE, 320, 240, 16, 0xf800, 0x7e0, 0x1f, 0);
+		if(!gui_screen) printf("Error creating surface gui\n");
 
-	// create 565 RGB surface
-	gui_screen = SDL_CreateRGBSurface(SDL_SWSURFACE, 320, 240, 16, 0xf800, 0x7e0, 0x1f, 0);
-	if(!gui_screen) printf("Error creating surface gui\n");
-
-	// Load bg image
-	// g_bg = SDL_LoadBMP("./bg.bmp");
-	g_bg = IMG_Load("./backdrop.png");
+		// Load bg image
+		// g_bg = SDL_LoadBMP("./bg.bmp");
+		g_bg = IMG_Load("./backdrop.png");
 
-	if (InitFont() < 0)
-		return -2;
+		if (InitFont() < 0)
+			return -2;
 
-	main_menu_items = sizeof(main_menu) / sizeof(main_menu[0]);
-
-	if (g_romtype != GIT_FDS) { // Remove "Flip disc" if not a FDS
-		for (int i = 3; i < main_menu_items - 1; i++)
-			main_menu[i] = main_menu[i+1];
-		main_menu_items--;
+		inited = 1;
 	}
 
 	if (gi) {
@@ -324,6 +324,14 @@ int FCEUGUI_Init(FCEUGI *gi)
 		g_romtype = gi->type;
 	}
 
+	// Rebuild the menu for the current game: "Flip disc" only for FDS
+	main_menu_items = 0;
+	for (int i = 0; i < (int)(sizeof(main_menu_all) / sizeof(main_menu_all[0])); i++) {
+		if (g_romtype != GIT_FDS && !strcmp(main_menu_all[i].name, "Flip disc"))
+			continue;
+		main_menu[main_menu_items++] = main_menu_all[i];
+	}
+
 	return 0;
 }
 
@@ -346,7 +354,10 @@ void FCEUGUI_Kill() {
 		SDL_FreeSurface(g_bg);
 	if (gui_screen)
 		SDL_FreeSurface(gui_screen);
+	gui_screen = NULL;
+	g_bg = NULL;
 	KillFont();
+	inited = 0;
 }
 
 void FCEUGUI_Run() {
@@ -354,8 +365,15 @@ void FCEUGUI_Run() {
 	static int spy = 72;
 	int done = 0, y, i;
 
+	FCEUGUI_Init(NULL);
 	load_preview();
 
+	// the menu may have lost "Flip disc" since the last time
+	if (index >= main_menu_items) {
+		index = 0;
+		spy = 72;
+	}
+
 	g_dirty = 1;
 	while (!done) {
 
@@ -27,6 +27,7 @@
 #include "config.h"
 
 #include "dingoo-video.h"
+#include "dingoo-hwout.h"
 #include "dingoo.h"
 #include "menu.h"
 #include "configfile.h"
@@ -306,7 +307,9 @@ static void KeyboardCommands() {
 		SilenceSound(1);
 		printf("Menu requested\n");
 		MenuRequested = false;
+		dingoo_video_suspend_hwout();
 		run_menu_loop();
+		dingoo_video_resume_hwout();
 		while (ispressed(FUNKEY_MENU) || ispressed(SDLK_b) || ispressed(SDLK_a)) { // wait for keyup
 			SDL_PumpEvents();
 		}
@@ -325,19 +328,34 @@ static void KeyboardCommands() {
 		resetkey(FUNKEY_AR_CHANGE);
 		aspect_ratio = (aspect_ratio+1)%NB_ASPECT_RATIOS_TYPES;
 
-		char shell_cmd_tmp[100];
-		FILE *fp_tmp;
-		sprintf(shell_cmd_tmp, "%s %d \"    DISPLAY MODE: %s\"", 
-			SHELL_CMD_NOTIF, NOTIF_SECONDS_DISP, aspect_ratio_name[aspect_ratio]);
-		fp_tmp = popen(shell_cmd_tmp, "r");
-		if (fp_tmp == NULL) {
-			printf("Failed to run command %s\n", shell_cmd_tmp);
+		// the system notification is drawn by SDL, which is hidden under the
+		// hardware output
+		if (HWOut_Active())
+			FCEU_DispMessage("Display mode: %s", 0, aspect_ratio_name[aspect_ratio]);
+		else {
+			char shell_cmd_tmp[100];
+			FILE *fp_tmp;
+			sprintf(shell_cmd_tmp, "%s %d \"    DISPLAY MODE: %s\"", 
+				SHELL_CMD_NOTIF, NOTIF_SECONDS_DISP, aspect_ratio_name[aspect_ratio]);
+			fp_tmp = popen(shell_cmd_tmp, "r");
+			if (fp_tmp == NULL) {
+				printf("Failed to run command %s\n", shell_cmd_tmp);
+			}
 		}
 
       // Save config file
       configfile_save(cfg_file_rom);
 	}
 
+	// step back one frame for as long as the key is held; movies are
+	// scrubbed through their state cache instead
+	if (ispressed(FUNKEY_REWIND) && gametype != GIT_NSF) {
+		if (FCEUMOV_IsLoaded())
+			FCEUMOV_SeekTo(FCEUMOV_GetFrame() - 2);
+		else
+			FCEUI_Rewind();
+	}
+
 #if 0
 	// toggle fastforwad
 	if(ispressed(DINGOO_L)) {
@@ -434,7 +452,7 @@ static void KeyboardCommands() {
 			 FCEUI_printf("Recording movie to %s\n", movie_fname);
 			 FCEUI_SaveMovie(movie_fname, MOVIE_FLAG_NONE, "");
 			 } else */
-			FCEUI_SaveState(NULL);
+			FCEUI_SaveStateAsync(NULL);
 		}
 
 		// f7 to load state, Shift-f7 to load movie
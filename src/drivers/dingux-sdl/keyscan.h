@@ -67,3 +67,4 @@
 
 #define FUNKEY_MENU SDLK_q
 #define FUNKEY_AR_CHANGE SDLK_h
+#define FUNKEY_REWIND SDLK_j
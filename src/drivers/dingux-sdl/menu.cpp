@@ -86,6 +86,7 @@ SDL_Surface * draw_screen;
 
 static int backup_key_repeat_delay, backup_key_repeat_interval;
 static SDL_Surface * backup_hw_screen = NULL;
+static bool menu_inited = false;
 
 static TTF_Font *menu_title_font = NULL;
 static TTF_Font *menu_info_font = NULL;
@@ -107,8 +108,8 @@ static uint16_t y_volume_bar = 0;
 static uint16_t x_brightness_bar = 0;
 static uint16_t y_brightness_bar = 0;
 
-int volume_percentage = 0;
-int brightness_percentage = 0;
+int volume_percentage = -1;		// -1 until read from the system
+int brightness_percentage = -1;
 
 #undef X
 #define X(a, b) b,
@@ -125,9 +126,40 @@ static void SaveStateTemp();
 static void DeleteStateTemp();
 
 /// -------------- FUNCTIONS IMPLEMENTATION --------------
+/// Draws the preview picture of a state file under the slot number, returns 0 if it has none
+static int draw_state_thumbnail(const char *fname){
+    static uint16_t pixels[FCEU_THUMBNAIL_WIDTH*FCEU_THUMBNAIL_HEIGHT];
+    if(!FCEUI_LoadStateThumbnail(fname, pixels)){
+        return 0;
+    }
+
+    SDL_Surface *thumbnail = SDL_CreateRGBSurfaceFrom(pixels, FCEU_THUMBNAIL_WIDTH, FCEU_THUMBNAIL_HEIGHT,
+        16, FCEU_THUMBNAIL_WIDTH*2, 0xF800, 0x07E0, 0x001F, 0);
+    if(thumbnail == NULL){
+        MENU_ERROR_PRINTF("ERROR Could not create thumbnail surface: %s\n", SDL_GetError());
+        return 0;
+    }
+    SDL_Rect pos;
+    pos.x = (draw_screen->w - FCEU_THUMBNAIL_WIDTH)/2;
+    pos.y = draw_screen->h - MENU_ZONE_HEIGHT/2 + padding_y_from_center_menu_zone*2/3;
+    SDL_BlitSurface(thumbnail, NULL, draw_screen, &pos);
+    SDL_FreeSurface(thumbnail);
+    return 1;
+}
+
+/// Loads fonts and images on first use so they stay off the startup path.
+/// Safe to call every time the menu opens.
 void init_menu_SDL(){
+    if(menu_inited){
+        return;
+    }
     MENU_DEBUG_PRINTF("Init Menu\n");
 
+    if(TTF_Init()){
+        fprintf(stderr, "Error TTF_Init: %s\n", TTF_GetError());
+        exit(EXIT_FAILURE);
+    }
+
     /// ----- Loading the fonts -----
     menu_title_font = TTF_OpenFont(MENU_FONT_NAME_TITLE, MENU_FONT_SIZE_TITLE);
     if(!menu_title_font){
@@ -167,9 +199,13 @@ void init_menu_SDL(){
 
     /// ------ Init menu zones ------
     init_menu_zones();
+    menu_inited = true;
 }
 
 void deinit_menu_SDL(){
+    if(!menu_inited){
+        return;
+    }
     MENU_DEBUG_PRINTF("End Menu \n");
 
     /// ------ Close font -------
@@ -193,6 +229,9 @@ void deinit_menu_SDL(){
     }
     idx_menus=NULL;
     nb_menu_zones = 0;
+
+    TTF_Quit();
+    menu_inited = false;
 }
 
     
@@ -499,18 +538,25 @@ void menu_screen_refresh(int menuItem, int prevItem, int scroll, uint8_t menu_co
                     if(file_exists(fname))
                     {
                         printf("Found Save slot: %s\n", fname);
-                        char *bname = basename(fname);
-                        if(strlen(bname) > limit_filename_size){bname[limit_filename_size]=0;} //limiting size
-                        text_surface = TTF_RenderText_Blended(menu_small_info_font,bname, text_color);
+                        if(draw_state_thumbnail(fname)){
+                            text_surface = NULL;
+                        }
+                        else{
+                            char *bname = basename(fname);
+                            if(strlen(bname) > limit_filename_size){bname[limit_filename_size]=0;} //limiting size
+                            text_surface = TTF_RenderText_Blended(menu_small_info_font,bname, text_color);
+                        }
                     }
                     else{
                         text_surface = TTF_RenderText_Blended(menu_info_font, "Free", text_color);
                     }
                 }
             }
-            text_pos.x = (draw_screen->w - MENU_ZONE_WIDTH)/2 + (MENU_ZONE_WIDTH - text_surface->w)/2;
-            text_pos.y = draw_screen->h - MENU_ZONE_HEIGHT/2 - text_surface->h/2 + 2*padding_y_from_center_menu_zone;
-            SDL_BlitSurface(text_surface, NULL, draw_screen, &text_pos);
+            if(text_surface){
+                text_pos.x = (draw_screen->w - MENU_ZONE_WIDTH)/2 + (MENU_ZONE_WIDTH - text_surface->w)/2;
+                text_pos.y = draw_screen->h - MENU_ZONE_HEIGHT/2 - text_surface->h/2 + 2*padding_y_from_center_menu_zone;
+                SDL_BlitSurface(text_surface, NULL, draw_screen, &text_pos);
+            }
             break;
 
         case MENU_TYPE_LOAD:
@@ -545,9 +591,14 @@ void menu_screen_refresh(int menuItem, int prevItem, int scroll, uint8_t menu_co
                         if(file_exists(fname))
                         {
                             printf("Found Load slot: %s\n", basename(fname));
-                            char *bname = basename(fname);
-                            if(strlen(bname) > limit_filename_size){bname[limit_filename_size]=0;} //limiting size
-                            text_surface = TTF_RenderText_Blended(menu_small_info_font,bname, text_color);
+                            if(draw_state_thumbnail(fname)){
+                                text_surface = NULL;
+                            }
+                            else{
+                                char *bname = basename(fname);
+                                if(strlen(bname) > limit_filename_size){bname[limit_filename_size]=0;} //limiting size
+                                text_surface = TTF_RenderText_Blended(menu_small_info_font,bname, text_color);
+                            }
                         }
                         else{
                             text_surface = TTF_RenderText_Blended(menu_info_font, "Free", text_color);
@@ -555,9 +606,11 @@ void menu_screen_refresh(int menuItem, int prevItem, int scroll, uint8_t menu_co
                     }
                 }
             }
-            text_pos.x = (draw_screen->w - MENU_ZONE_WIDTH)/2 + (MENU_ZONE_WIDTH - text_surface->w)/2;
-            text_pos.y = draw_screen->h - MENU_ZONE_HEIGHT/2 - text_surface->h/2 + 2*padding_y_from_center_menu_zone;
-            SDL_BlitSurface(text_surface, NULL, draw_screen, &text_pos);
+            if(text_surface){
+                text_pos.x = (draw_screen->w - MENU_ZONE_WIDTH)/2 + (MENU_ZONE_WIDTH - text_surface->w)/2;
+                text_pos.y = draw_screen->h - MENU_ZONE_HEIGHT/2 - text_surface->h/2 + 2*padding_y_from_center_menu_zone;
+                SDL_BlitSurface(text_surface, NULL, draw_screen, &text_pos);
+            }
             break;
 
         case MENU_TYPE_ASPECT_RATIO:
@@ -615,6 +668,7 @@ void menu_screen_refresh(int menuItem, int prevItem, int scroll, uint8_t menu_co
 void run_menu_loop()
 {
     MENU_DEBUG_PRINTF("Launch Menu\n");
+    init_menu_SDL();
 
     SDL_Event event;
     uint32_t prev_ms = SDL_GetTicks();
@@ -857,7 +911,7 @@ void run_menu_loop()
 
                                 /// ------ Save game ------
                                 FCEUI_SelectState(savestate_slot, 0);
-                                FCEUI_SaveState(NULL);
+                                FCEUI_SaveStateAsync(NULL);
                             
                                 /// ----- Hud Msg -----
                                 sprintf(shell_cmd, "%s %d \"        SAVED IN SLOT %d\"", 
@@ -920,7 +974,8 @@ void run_menu_loop()
                                 MENU_DEBUG_PRINTF("Exit game - confirmed\n");
                                 
                                 /// ----- The game is quick saved here ----
-                                FCEUI_SaveState(quick_save_file);
+                                /// (CloseGame waits for the write to finish)
+                                FCEUI_SaveStateAsync(quick_save_file);
 
                                 /// ----- Exit game and back to launcher ----
                                 CloseGame();
@@ -1009,6 +1064,7 @@ void run_menu_loop()
 int launch_resume_menu_loop()
 {
     MENU_DEBUG_PRINTF("Init resume menu\n");
+    init_menu_SDL();
 
     /* Decare vars */
     SDL_Surface *text_surface = NULL;
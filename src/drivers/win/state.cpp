@@ -7,9 +7,6 @@
 
 using namespace std;
 
-//Externs
-extern string GetBackupFileName();			//Declared in src/state.cpp
-
 /**
 * Show an Save File dialog and save a savegame state to the selected file.
 **/
@@ -423,7 +423,7 @@ static void DeleteFrames()
 	int ctr=0;
 	for(TSelectionFrames::reverse_iterator it(selectionFrames.rbegin()); it != selectionFrames.rend(); it++)
 	{
-		currMovieData.records.erase(currMovieData.records.begin()+*it);
+		currMovieData.records.erase(*it, 1);
 	}
 
 	int index = *selectionFrames.begin();
@@ -23,7 +23,7 @@ extern GREENZONE greenzone;
 extern HISTORY history;
 
 extern uint8 *XBuf;
-extern uint8 *XBackBuf;
+extern uint8 *FCEU_GetBackBuf(void);
 
 BOOKMARK::BOOKMARK()
 {
@@ -79,7 +79,7 @@ void BOOKMARK::set()
 	if (taseditorConfig.HUDInBranchScreenshots)
 		compress(&savedScreenshot[0], &comprlen, XBuf, SCREENSHOT_SIZE);
 	else
-		compress(&savedScreenshot[0], &comprlen, XBackBuf, SCREENSHOT_SIZE);
+		compress(&savedScreenshot[0], &comprlen, FCEU_GetBackBuf(), SCREENSHOT_SIZE);
 	savedScreenshot.resize(comprlen);
 
 	notEmpty = true;
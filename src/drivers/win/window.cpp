@@ -491,7 +491,7 @@ void UpdateContextMenuItems(HMENU context, int whichContext)
 	CheckMenuItem(context,ID_CONTEXT_FULLSAVESTATES,MF_BYCOMMAND | (fullSaveStateLoads ? MF_CHECKED : MF_UNCHECKED));
 
 	//Undo Loadstate
-	if (CheckBackupSaveStateExist() && (undoLS || redoLS))
+	if (undoLS || redoLS)
 		EnableMenuItem(context,FCEUX_CONTEXT_UNDOLOADSTATE,MF_BYCOMMAND | MF_ENABLED);
 	else
 		EnableMenuItem(context,FCEUX_CONTEXT_UNDOLOADSTATE,MF_BYCOMMAND | MF_GRAYED);
@@ -2260,9 +2260,9 @@ LRESULT FAR PASCAL AppWndProc(HWND hWnd,UINT msg,WPARAM wParam,LPARAM lParam)
 
 			//Undo Loadstate
 			case FCEUX_CONTEXT_UNDOLOADSTATE:
-				if (CheckBackupSaveStateExist() && redoLS)
+				if (redoLS)
 					RedoLoadState();
-				else if (CheckBackupSaveStateExist() && undoLS)
+				else if (undoLS)
 					LoadBackup();
 				break;
 
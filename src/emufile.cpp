@@ -96,6 +96,7 @@ EMUFILE* EMUFILE_FILE::memwrap()
 {
 	EMUFILE_MEMORY* mem = new EMUFILE_MEMORY(size());
 	if(size()==0) return mem;
+	fseek(0,SEEK_SET);
 	fread(mem->buf(),size());
 	return mem;
 }
@@ -42,6 +42,9 @@
 #include "input.h"
 #include "file.h"
 #include "vsuni.h"
+#include "rewind.h"
+#include "runahead.h"
+#include "moviecache.h"
 #include "ines.h"
 #if defined(WIN32) && !defined(DINGUX)
 #include "drivers/win/pref.h"
@@ -167,6 +170,8 @@ static void FCEU_CloseGame(void)
 {
 	if (GameInfo)
 	{
+		FCEUSS_WaitSaves();
+
 		if (AutoResumePlay)
 		{
 			// save "-resume" savestate
@@ -219,6 +224,11 @@ static void FCEU_CloseGame(void)
 		undoLS = false;
 		redoLS = false;
 		AutoSS = false;
+
+		FCEU_RewindReset();
+
+		//everything the game allocated goes at once, after its close hooks
+		FCEU_ArenaRelease();
 	}
 }
 
@@ -449,6 +459,7 @@ FCEUGI *FCEUI_LoadGameVirtual(const char *name, int OverwriteVidMode, bool silen
 		AutosaveStatus[AutosaveIndex] = 0;
 
 	FCEU_CloseGame();
+	FCEU_ArenaOpen();
 	GameInfo = new FCEUGI();
 	memset(GameInfo, 0, sizeof(FCEUGI));
 
@@ -485,6 +496,7 @@ FCEUGI *FCEUI_LoadGameVirtual(const char *name, int OverwriteVidMode, bool silen
 
 	delete GameInfo;
 	GameInfo = 0;
+	FCEU_ArenaRelease();
 
 	return 0;
 
@@ -604,6 +616,7 @@ bool FCEUI_Initialize() {
 }
 
 void FCEUI_Kill(void) {
+	FCEUSS_WaitSaves();
 	#ifdef _S9XLUA_H
 	FCEU_LuaStop();
 	#endif
@@ -658,11 +671,18 @@ void UpdateAutosave(void);
 
 ///Skip may be passed in, if FRAMESKIP is #defined, to cause this to emulate more than one frame
 void FCEUI_Emulate(uint8 **pXBuf, int32 **SoundBuf, int32 *SoundBufSize, int skip) {
-	//skip initiates frame skip if 1, or frame skip and sound skip if 2
+	//skip initiates frame skip if 1, or frame skip and sound skip if 2, or only sound skip if 3
 	int r, ssize;
+	int videoskip = skip == 3 ? 0 : skip;
 
 	JustFrameAdvanced = false;
 
+	if (FCEU_RewindEmulate(pXBuf, SoundBuf, SoundBufSize, skip))
+		return;
+
+	if (!frameAdvanceRequested && FCEU_RunAheadEmulate(pXBuf, SoundBuf, SoundBufSize, skip))
+		return;
+
 	if (frameAdvanceRequested)
 	{
 		if (frameAdvance_Delay_count == 0 || frameAdvance_Delay_count >= frameAdvance_Delay)
@@ -697,7 +717,7 @@ void FCEUI_Emulate(uint8 **pXBuf, int32 **SoundBuf, int32 *SoundBufSize, int ski
 		if (EmulationPaused & EMULATIONPAUSED_PAUSED)
 		{
 			// emulator is paused
-			memcpy(XBuf, XBackBuf, 256*256);
+			FCEU_RestoreBackBuf();
 			FCEU_PutImage();
 			*pXBuf = XBuf;
 			*SoundBuf = WaveFinal;
@@ -706,8 +726,14 @@ void FCEUI_Emulate(uint8 **pXBuf, int32 **SoundBuf, int32 *SoundBufSize, int ski
 		}
 	}
 
-	AutoFire();
-	UpdateAutosave();
+	if (!FCEU_RunAheadSpeculating())
+	{
+		AutoFire();
+		UpdateAutosave();
+		FCEU_SaveGameUpdate();
+		FCEU_RewindUpdate();
+		FCEUMOV_CacheUpdate();
+	}
 
 #ifdef _S9XLUA_H
 	FCEU_LuaFrameBoundary();
@@ -721,9 +747,9 @@ void FCEUI_Emulate(uint8 **pXBuf, int32 **SoundBuf, int32 *SoundBufSize, int ski
 #endif
 
 	if (geniestage != 1) FCEU_ApplyPeriodicCheats();
-	r = FCEUPPU_Loop(skip);
+	r = FCEUPPU_Loop(videoskip);
 
-	if (skip != 2) ssize = FlushEmulateSound();  //If skip = 2 we are skipping sound processing
+	if (skip < 2) ssize = FlushEmulateSound();  //If skip = 2 or 3 we are skipping sound processing
 
 #ifdef _S9XLUA_H
 	CallRegisteredLuaFunctions(LUACALL_AFTEREMULATION);
@@ -746,8 +772,8 @@ void FCEUI_Emulate(uint8 **pXBuf, int32 **SoundBuf, int32 *SoundBufSize, int ski
 	timestamp = 0;
 	soundtimestamp = 0;
 
-	*pXBuf = skip ? 0 : XBuf;
-	if (skip == 2) { //If skip = 2, then bypass sound
+	*pXBuf = videoskip ? 0 : XBuf;
+	if (skip >= 2) { //If skip = 2 or 3, then bypass sound
 		*SoundBuf = 0;
 		*SoundBufSize = 0;
 	} else {
@@ -767,10 +793,13 @@ void FCEUI_Emulate(uint8 **pXBuf, int32 **SoundBuf, int32 *SoundBufSize, int ski
 		#endif
 	}
 
-	if (lagFlag) {
-		lagCounter++;
-		justLagged = true;
-	} else justLagged = false;
+	if (!FCEU_RunAheadSpeculating())
+	{
+		if (lagFlag) {
+			lagCounter++;
+			justLagged = true;
+		} else justLagged = false;
+	}
 
 	if (movieSubtitles)
 		ProcessSubtitles();
@@ -794,6 +823,8 @@ void ResetNES(void) {
 	// clear back baffer
 	extern uint8 *XBackBuf;
 	memset(XBackBuf, 0, 256 * 256);
+	FCEU_BackBufLoaded();
+	FCEU_RewindReset();
 
 	FCEU_DispMessage("Reset", 0);
 }
@@ -869,6 +900,8 @@ void PowerNES(void) {
 	// clear back buffer
 	extern uint8 *XBackBuf;
 	memset(XBackBuf, 0, 256 * 256);
+	FCEU_BackBufLoaded();
+	FCEU_RewindReset();
 
 #if defined(WIN32) && !defined(DINGUX)
 	Update_RAM_Search(); // Update_RAM_Watch() is also called.
@@ -904,7 +937,7 @@ void FCEU_ResetVidSys(void) {
 
 FCEUS FSettings;
 
-void FCEU_printf(char *format, ...) {
+void FCEU_printf(const char *format, ...) {
 	char temp[2048];
 
 	va_list ap;
@@ -923,7 +956,7 @@ void FCEU_printf(char *format, ...) {
 	va_end(ap);
 }
 
-void FCEU_PrintError(char *format, ...) {
+void FCEU_PrintError(const char *format, ...) {
 	char temp[2048];
 
 	va_list ap;
@@ -125,10 +125,10 @@ extern FCEUS FSettings;
 
 bool CheckFileExists(const char* filename);	//Receives a filename (fullpath) and checks to see if that file exists
 
-void FCEU_PrintError(char *format, ...);
-void FCEU_printf(char *format, ...);
-void FCEU_DispMessage(char *format, int disppos, ...);
-void FCEU_DispMessageOnMovie(char *format, ...);
+void FCEU_PrintError(const char *format, ...);
+void FCEU_printf(const char *format, ...);
+void FCEU_DispMessage(const char *format, int disppos, ...);
+void FCEU_DispMessageOnMovie(const char *format, ...);
 void FCEU_TogglePPU();
 
 void SetNESDeemph_OldHacky(uint8 d, int force);
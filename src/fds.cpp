@@ -571,7 +571,7 @@ static void FreeFDSMemory(void) {
 
 	for (x = 0; x < TotalSides; x++)
 		if (diskdata[x]) {
-			free(diskdata[x]);
+			FCEU_gfree(diskdata[x]);
 			diskdata[x] = 0;
 		}
 }
@@ -602,11 +602,11 @@ static int SubLoad(FCEUFILE *fp) {
 	if (TotalSides < 1) TotalSides = 1;
 
 	for (x = 0; x < TotalSides; x++) {
-		diskdata[x] = (uint8*)FCEU_malloc(65500);
+		diskdata[x] = (uint8*)FCEU_gtrymalloc(65500);
 		if (!diskdata[x]) {
 			int zol;
 			for (zol = 0; zol < x; zol++)
-				free(diskdata[zol]);
+				FCEU_gfree(diskdata[zol]);
 			return 0;
 		}
 		FCEU_fread(diskdata[x], 1, 65500, fp);
@@ -659,13 +659,13 @@ int FDSLoad(const char *name, FCEUFILE *fp) {
 	ResetCartMapping();
 
 	if(FDSBIOS)
-		free(FDSBIOS);
+		FCEU_gfree(FDSBIOS);
 	FDSBIOS = NULL;
 	if(FDSRAM)
-		free(FDSRAM);
+		FCEU_gfree(FDSRAM);
 	FDSRAM = NULL;
 	if(CHRRAM)
-		free(CHRRAM);
+		FCEU_gfree(CHRRAM);
 	CHRRAM = NULL;
 
 	FDSBIOSsize = 8192;
@@ -674,7 +674,7 @@ int FDSLoad(const char *name, FCEUFILE *fp) {
 
 	if (fread(FDSBIOS, 1, FDSBIOSsize, zp) != FDSBIOSsize) {
 		if(FDSBIOS)
-			free(FDSBIOS);
+			FCEU_gfree(FDSBIOS);
 		FDSBIOS = NULL;
 		fclose(zp);
 		FCEU_PrintError("Error reading FDS BIOS ROM image.");
@@ -688,7 +688,7 @@ int FDSLoad(const char *name, FCEUFILE *fp) {
 	FreeFDSMemory();
 	if (!SubLoad(fp)) {
 		if(FDSBIOS)
-			free(FDSBIOS);
+			FCEU_gfree(FDSBIOS);
 		FDSBIOS = NULL;
 		return(0);
 	}
@@ -699,7 +699,7 @@ int FDSLoad(const char *name, FCEUFILE *fp) {
 
 		int x;
 		for (x = 0; x < TotalSides; x++) {
-			diskdatao[x] = (uint8*)FCEU_malloc(65500);
+			diskdatao[x] = (uint8*)FCEU_gmalloc(65500);
 			memcpy(diskdatao[x], diskdata[x], 65500);
 		}
 
@@ -709,7 +709,7 @@ int FDSLoad(const char *name, FCEUFILE *fp) {
 			if (!SubLoad(tp)) {
 				FCEU_PrintError("Error reading auxillary FDS file.");
 				if(FDSBIOS)
-					free(FDSBIOS);
+					FCEU_gfree(FDSBIOS);
 				FDSBIOS = NULL;
 				free(fn);
 				return(0);
@@ -793,19 +793,19 @@ void FDSClose(void) {
 
 	for (x = 0; x < TotalSides; x++)
 		if (diskdatao[x]) {
-			free(diskdatao[x]);
+			FCEU_gfree(diskdatao[x]);
 			diskdatao[x] = 0;
 		}
 
 	FreeFDSMemory();
 	if(FDSBIOS)
-		free(FDSBIOS);
+		FCEU_gfree(FDSBIOS);
 	FDSBIOS = NULL;
 	if(FDSRAM)
-		free(FDSRAM);
+		FCEU_gfree(FDSRAM);
 	FDSRAM = NULL;
 	if(CHRRAM)
-		free(CHRRAM);
+		FCEU_gfree(CHRRAM);
 	CHRRAM = NULL;
 	fclose(fp);
 }
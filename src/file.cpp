@@ -44,9 +44,12 @@
 #include "movie.h"
 #include "driver.h"
 #include "utils/xstring.h"
+#include "utils/asyncio.h"
 
 #ifndef WIN32
 #include <zlib.h>
+#include <unistd.h>
+#include <sys/mman.h>
 #endif
 
 using namespace std;
@@ -186,6 +189,167 @@ FileBaseInfo DetermineFileBase(const char *f) {
 
 inline FileBaseInfo DetermineFileBase(const std::string& str) { return DetermineFileBase(str.c_str()); }
 
+//A compressed file read through a small buffer and inflated on demand, so a
+//loader's fread lands straight in its own allocation instead of in a full size
+//copy of the file. Seeking forward inflates and drops the bytes skipped;
+//seeking back past the buffer starts inflating again from the top.
+class EMUFILE_INFLATE : public EMUFILE {
+protected:
+	int pos, len;			//logical position and uncompressed size
+	u8 buf[4096];
+	int bufpos, buflen;		//buf holds the bytes at pos - bufpos .. pos - bufpos + buflen
+
+	//returns the number of bytes inflated, 0 at the end and -1 on errors
+	virtual int readraw(void *ptr, int bytes) = 0;
+	//goes back to the start of the data
+	virtual bool restart() = 0;
+
+public:
+	EMUFILE_INFLATE(int len)
+		: pos(0), len(len), bufpos(0), buflen(0)
+	{}
+
+	virtual FILE *get_fp() { return NULL; }
+
+	virtual EMUFILE* memwrap() {
+		EMUFILE_MEMORY* mem = new EMUFILE_MEMORY(len);
+		if(len && (fseek(0,SEEK_SET) || _fread(mem->buf(),len) != (size_t)len))
+			failbit = true;
+		return mem;
+	}
+
+	virtual void truncate(s32 length) { failbit = true; }
+	virtual int fprintf(const char *format, ...) { failbit = true; return 0; }
+	virtual int fputc(int c) { failbit = true; return EOF; }
+	virtual void fwrite(const void *ptr, size_t bytes) { failbit = true; }
+	virtual void fflush() {}
+
+	virtual int fgetc() {
+		u8 c;
+		return _fread(&c,1) == 1 ? c : EOF;
+	}
+
+	virtual size_t _fread(const void *ptr, size_t bytes) {
+		u8* dst = (u8*)ptr;
+		size_t done = 0;
+		while(done < bytes)
+		{
+			size_t want = bytes - done;
+			if(bufpos == buflen && want >= sizeof(buf))
+			{
+				//big reads inflate straight into the destination
+				int got = readraw(dst + done, (int)want);
+				if(got <= 0) break;
+				done += got;
+				bufpos = buflen = 0;
+				continue;
+			}
+			if(bufpos == buflen)
+			{
+				int got = readraw(buf, sizeof(buf));
+				if(got <= 0) break;
+				bufpos = 0;
+				buflen = got;
+			}
+			size_t n = std::min<size_t>(want, buflen - bufpos);
+			memcpy(dst + done, buf + bufpos, n);
+			bufpos += n;
+			done += n;
+		}
+		pos += done;
+		if(done < bytes)
+			failbit = true;
+		return done;
+	}
+
+	virtual int fseek(int offset, int origin) {
+		int target = offset;
+		if(origin == SEEK_CUR) target += pos;
+		else if(origin == SEEK_END) target += len;
+		if(target < 0 || target > len) return -1;
+
+		if(target >= pos - bufpos && target <= pos - bufpos + buflen)
+		{
+			//still in the buffer, which covers unget and rereading a header
+			bufpos += target - pos;
+			pos = target;
+			return 0;
+		}
+		if(target < pos)
+		{
+			if(!restart()) return -1;
+			pos = bufpos = buflen = 0;
+		}
+		while(pos < target)
+		{
+			u8 skip[4096];
+			int n = std::min<int>(target - pos, sizeof(skip));
+			if(_fread(skip,n) != (size_t)n) return -1;
+		}
+		return 0;
+	}
+
+	virtual int ftell() { return pos; }
+	virtual int size() { return len; }
+};
+
+class EMUFILE_UNZIP : public EMUFILE_INFLATE {
+	unzFile tz;
+protected:
+	virtual int readraw(void *ptr, int bytes) { return unzReadCurrentFile(tz,ptr,bytes); }
+	virtual bool restart() {
+		unzCloseCurrentFile(tz);
+		return unzOpenCurrentFile(tz) == UNZ_OK;
+	}
+public:
+	//takes over tz, with its current file open
+	EMUFILE_UNZIP(unzFile tz, int len) : EMUFILE_INFLATE(len), tz(tz) {}
+	virtual ~EMUFILE_UNZIP() {
+		unzCloseCurrentFile(tz);
+		unzClose(tz);
+	}
+};
+
+class EMUFILE_GZIP : public EMUFILE_INFLATE {
+	gzFile gz;
+protected:
+	virtual int readraw(void *ptr, int bytes) { return gzread(gz,ptr,bytes); }
+	virtual bool restart() { return gzrewind(gz) == 0; }
+public:
+	EMUFILE_GZIP(gzFile gz, int len) : EMUFILE_INFLATE(len), gz(gz) {}
+	virtual ~EMUFILE_GZIP() { gzclose(gz); }
+};
+
+//The gzip trailer holds the size of the last member only, modulo 2^32, so it is
+//wrong for concatenated members and for huge files. Checks that the data ends
+//exactly there, without keeping any of it, and rewinds.
+static bool GzipSizeIs(gzFile gz, u32 size)
+{
+	u8 scratch[16384];
+	u32 done = 0;
+	while(done < size)
+	{
+		int got = gzread(gz, scratch, std::min<u32>(size - done, sizeof(scratch)));
+		if(got <= 0) break;
+		done += got;
+	}
+	bool ok = done == size && gzread(gz, scratch, 1) == 0;
+	return gzrewind(gz) == 0 && ok;
+}
+
+//Inflates the whole file into a buffer that grows as it goes
+static EMUFILE_MEMORY* GzipToMemory(gzFile gz)
+{
+	EMUFILE_MEMORY* ms = new EMUFILE_MEMORY();
+	u8 chunk[16384];
+	int got;
+	while((got = gzread(gz, chunk, sizeof(chunk))) > 0)
+		ms->fwrite(chunk, got);
+	gzclose(gz);
+	ms->fseek(0, SEEK_SET);
+	return ms;
+}
+
 static FCEUFILE * TryUnzip(const std::string& path) {
 	unzFile tz;
 	if((tz=unzOpen(path.c_str())))  // If it's not a zip file, use regular file handlers.
@@ -240,14 +404,10 @@ zpfail:
 		unz_file_info ufo;
 		unzGetCurrentFileInfo(tz,&ufo,0,0,0,0,0,0);
 
+		//inflated as the loader reads it
 		int size = ufo.uncompressed_size;
-		EMUFILE_MEMORY* ms = new EMUFILE_MEMORY(size);
-		unzReadCurrentFile(tz,ms->buf(),ufo.uncompressed_size);
-		unzCloseCurrentFile(tz);
-		unzClose(tz);
-
 		FCEUFILE *fceufp = new FCEUFILE();
-		fceufp->stream = ms;
+		fceufp->stream = new EMUFILE_UNZIP(tz,size);
 		fceufp->size = size;
 		return fceufp;
 
@@ -256,7 +416,7 @@ zpfail:
 	return 0;
 }
 
-FCEUFILE * FCEU_fopen(const char *path, const char *ipsfn, char *mode, char *ext, int index, const char** extensions)
+FCEUFILE * FCEU_fopen(const char *path, const char *ipsfn, const char *mode, const char *ext, int index, const char** extensions)
 {
 	FILE *ipsfile=0;
 	FCEUFILE *fceufp=0;
@@ -316,22 +476,28 @@ FCEUFILE * FCEU_fopen(const char *path, const char *ipsfn, char *mode, char *ext
 
 					gzFile gzfile = gzopen(fileToOpen.c_str(),"rb");
 					if(gzfile) {
+						//stream with the size from the trailer when it holds up,
+						//otherwise inflate into memory to learn the real one
+						u32 size = 0;
+						fp->fseek(-4,SEEK_END);
+						fp->read32le(&size);
 						delete fp;
 
-						int size;
-						for(size=0; gzgetc(gzfile) != EOF; size++) {}
-						EMUFILE_MEMORY* ms = new EMUFILE_MEMORY(size);
-						gzseek(gzfile,0,SEEK_SET);
-						gzread(gzfile,ms->buf(),size);
-						gzclose(gzfile);
-
 						fceufp = new FCEUFILE();
 						fceufp->filename = fileToOpen;
 						fceufp->logicalPath = fileToOpen;
 						fceufp->fullFilename = fileToOpen;
 						fceufp->archiveIndex = -1;
-						fceufp->stream = ms;
-						fceufp->size = size;
+						if(size <= 0x7FFFFFFF && GzipSizeIs(gzfile,size))
+						{
+							fceufp->stream = new EMUFILE_GZIP(gzfile,size);
+							fceufp->size = size;
+						}
+						else
+						{
+							fceufp->stream = GzipToMemory(gzfile);
+							fceufp->size = fceufp->stream->size();
+						}
 						goto applyips;
 					}
 				}
@@ -434,6 +600,136 @@ int FCEU_fisarchive(FCEUFILE *fp)
 	else return 1;
 }
 
+uint8 *FCEU_fmap(FCEUFILE *fp, uint32 len)
+{
+#ifdef WIN32
+	return 0;
+#else
+	//unzipped, gunzipped and patched images live in memory streams
+	FILE *f = fp->stream->get_fp();
+	if(!f || !len) return 0;
+
+	uint32 offset = fp->stream->ftell();
+	if((uint64)offset + len > (uint64)fp->size) return 0;
+
+	//mmap wants a page aligned offset
+	uint32 slack = offset % sysconf(_SC_PAGESIZE);
+	void *base = mmap(0, len + slack, PROT_READ | PROT_WRITE, MAP_PRIVATE, fileno(f), offset - slack);
+	if(base == MAP_FAILED) return 0;
+
+	fp->stream->fseek(offset + len, SEEK_SET);
+	return (uint8*)base + slack;
+#endif
+}
+
+void FCEU_funmap(uint8 *ptr, uint32 len)
+{
+#ifndef WIN32
+	uint32 slack = (uintptr_t)ptr % sysconf(_SC_PAGESIZE);
+	munmap(ptr - slack, len + slack);
+#endif
+}
+
+//The hash cache is a text file, newest entry first, one line per file:
+//  <crc32, 8 hex digits> <md5, 32 hex digits> <size> <mtime> <path>
+#define HASHCACHE_ENTRIES	64
+#define HASHCACHE_KEYPOS	42	//where <size> starts
+
+static bool ROMHashKey(FCEUFILE *fp, std::string &key)
+{
+	if(!fp->stream->get_fp()) return false;
+
+	struct stat fileInfo;
+	if(stat(fp->fullFilename.c_str(), &fileInfo)) return false;
+
+	char buf[64];
+	sprintf(buf, "%d %ld ", fp->size, (long)fileInfo.st_mtime);
+	key = buf + fp->fullFilename;
+	return true;
+}
+
+static void ReadROMHashCache(const std::string &fn, std::vector<std::string> &lines)
+{
+	std::ifstream in(fn.c_str());
+	std::string line;
+	while(std::getline(in, line) && lines.size() < HASHCACHE_ENTRIES)
+		if(line.size() > HASHCACHE_KEYPOS)
+			lines.push_back(line);
+}
+
+bool FCEU_LookupROMHash(FCEUFILE *fp, uint8 md5[16], uint32 *crc32)
+{
+	std::string key;
+	if(!ROMHashKey(fp, key)) return false;
+
+	std::vector<std::string> lines;
+	ReadROMHashCache(FCEU_MakeFName(FCEUMKF_HASHCACHE,0,0), lines);
+	for(size_t i = 0; i < lines.size(); i++)
+	{
+		if(lines[i].compare(HASHCACHE_KEYPOS, std::string::npos, key)) continue;
+
+		const char *s = lines[i].c_str();
+		unsigned int v;
+		if(sscanf(s, "%8x", &v) != 1) return false;
+		*crc32 = v;
+		for(int x = 0; x < 16; x++)
+		{
+			if(sscanf(s + 9 + x * 2, "%2x", &v) != 1) return false;
+			md5[x] = v;
+		}
+		return true;
+	}
+	return false;
+}
+
+//Puts a new entry at the top of the cache file. Runs on the writer thread, so
+//entries stored one after another each see the file the one before wrote.
+class ROMHASHWRITEJOB : public ASYNCJOB
+{
+public:
+	std::string fname;
+	std::string key;
+	std::string entry;	//the whole line, key included
+
+	virtual void run()
+	{
+		std::vector<std::string> lines;
+		ReadROMHashCache(fname, lines);
+
+		std::string out = entry + "\n";
+		int kept = 1;
+		for(size_t i = 0; i < lines.size() && kept < HASHCACHE_ENTRIES; i++)
+		{
+			if(!lines[i].compare(HASHCACHE_KEYPOS, std::string::npos, key)) continue;
+			out += lines[i] + "\n";
+			kept++;
+		}
+
+		//only a cache: a failed write just means hashing the ROM again
+		if(!FCEU_WriteFileAtomic(fname.c_str(), out.data(), out.size()))
+			FCEU_printf("Couldn't write %s\n", fname.c_str());
+	}
+};
+
+void FCEU_StoreROMHash(FCEUFILE *fp, const uint8 md5[16], uint32 crc32)
+{
+	std::string key;
+	if(!ROMHashKey(fp, key)) return;
+
+	char buf[HASHCACHE_KEYPOS + 1];
+	sprintf(buf, "%08x ", crc32);
+	for(int x = 0; x < 16; x++)
+		sprintf(buf + 9 + x * 2, "%02x", md5[x]);
+	strcat(buf, " ");
+
+	//the load goes on while the writer thread updates the file
+	ROMHASHWRITEJOB *job = new ROMHASHWRITEJOB();
+	job->fname = FCEU_MakeFName(FCEUMKF_HASHCACHE,0,0);
+	job->key = key;
+	job->entry = buf + key;
+	FCEU_AsyncSubmit(job);
+}
+
 std::string GetMfn() //Retrieves the movie filename from curMovieFilename (for adding to savestate and auto-save files)
 {
 	std::string movieFilenamePart;
@@ -754,7 +1050,10 @@ std::string FCEU_MakeFName(int type, int id1, const char *cd1)
 				sprintf(ret,"%s" PSS "fcs" PSS "%s*.fc?",BaseDirectory.c_str(),FileBase);
 			break;
 		case FCEUMKF_CFG:
-			sprintf(ret,"%s"PSS"cfg"PSS"%s.cfg",BaseDirectory.c_str(),FileBase);
+			sprintf(ret,"%s" PSS "cfg" PSS "%s.cfg",BaseDirectory.c_str(),FileBase);
+			break;
+		case FCEUMKF_HASHCACHE:
+			sprintf(ret,"%s" PSS "romhash.cache",BaseDirectory.c_str());
 			break;
 	}
 
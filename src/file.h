@@ -58,15 +58,14 @@ struct FCEUFILE {
 	//guarantees that the file contains a memorystream, and returns it for your convenience
 	EMUFILE_MEMORY* EnsureMemorystream() {
 
-		EMUFILE_MEMORY* ret = static_cast<EMUFILE_MEMORY*>(stream);
-		if(ret) return ret;
-
-		//nope, we need to create it: copy the contents
-		ret = new EMUFILE_MEMORY(size);
-		stream->fread(ret->buf(),size);
-		delete stream;
-		stream = ret;
-		return ret;
+		//memory streams wrap to themselves; files and compressed streams
+		//are read in whole
+		EMUFILE* mem = stream->memwrap();
+		if(mem != stream) {
+			delete stream;
+			stream = mem;
+		}
+		return static_cast<EMUFILE_MEMORY*>(stream);
 	}
 
 	void SetStream(EMUFILE *newstream) {
@@ -123,7 +122,7 @@ struct ArchiveScanRecord
 };
 
 
-FCEUFILE *FCEU_fopen(const char *path, const char *ipsfn, char *mode, char *ext, int index=-1, const char** extensions = 0);
+FCEUFILE *FCEU_fopen(const char *path, const char *ipsfn, const char *mode, const char *ext, int index=-1, const char** extensions = 0);
 bool FCEU_isFileInArchive(const char *path);
 int FCEU_fclose(FCEUFILE*);
 uint64 FCEU_fread(void *ptr, size_t size, size_t nmemb, FCEUFILE*);
@@ -136,6 +135,24 @@ int FCEU_fgetc(FCEUFILE*);
 uint64 FCEU_fgetsize(FCEUFILE*);
 int FCEU_fisarchive(FCEUFILE*);
 
+//Maps the next len bytes of a plain file read-only into memory, copy-on-write:
+//pages that get written become private copies, the others stay shared with the
+//page cache. Advances the file position like FCEU_fread. Returns NULL for
+//archives, IPS patched files, short files and where there is no mmap.
+//The pages that were never written keep reading the file, so if it shrinks
+//or its storage goes away while mapped (the ROM truncated or replaced in
+//place, the SD card pulled), touching them raises SIGBUS. Only use it for
+//files that stay put for as long as the mapping lives.
+uint8 *FCEU_fmap(FCEUFILE*, uint32 len);
+void FCEU_funmap(uint8 *ptr, uint32 len);
+
+//The MD5 and CRC32 a loader computed for a plain file, remembered by path,
+//size and modification time so the next load of it needn't hash it again.
+//Archives and IPS patched files are never cached. Storing hands the file
+//update to the background writer (utils/asyncio.h).
+bool FCEU_LookupROMHash(FCEUFILE*, uint8 md5[16], uint32 *crc32);
+void FCEU_StoreROMHash(FCEUFILE*, const uint8 md5[16], uint32 crc32);
+
 
 
 void GetFileBase(const char *f);
@@ -169,4 +186,5 @@ void FCEU_SplitArchiveFilename(std::string src, std::string& archive, std::strin
 #define FCEUMKF_TASEDITOR    22
 #define FCEUMKF_RESUMESTATE  23
 #define FCEUMKF_CFG          24
+#define FCEUMKF_HASHCACHE    25
 #endif
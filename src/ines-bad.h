@@ -1,40 +1,39 @@
-{ 0xecf78d8a13a030a6LL, "Ai Sensei no Oshiete", INESB_HACKED },
-{ 0x4712856d3e12f21fLL, "Akumajou Densetsu", INESB_HACKED },
-{ 0x10f90ba5bd55c22eLL, "Alien Syndrome", INESB_HACKED },
+{ 0x001c0bb9c358252aLL, "110-in-1", INESB_CORRUPT },
+{ 0x02bdcf375704784bLL, "Erika to Satoru no Yume Bouken", INESB_HACKED },
+{ 0x04afae4ad480c11cLL, "Gradius 2", INESB_HACKED },
 { 0x0d69ab3ad28ad1c2LL, "Banana", INESB_INCOMPLETE },
-{ 0x85d2c348a161cdbfLL, "Bio Senshi Dan", INESB_HACKED },
+{ 0x103fc85d978b861bLL, "Sweet Home", INESB_CORRUPT },
+{ 0x10f90ba5bd55c22eLL, "Alien Syndrome", INESB_HACKED },
+{ 0x1895afc6eef26c7dLL, "Super Mario Bros.", INESB_HACKED },
 { 0x18fdb7c16aa8cb5cLL, "Bucky O'Hare", INESB_CORRUPT },
-{ 0xe27c48302108d11bLL, "Chibi Maruko Chan", INESB_HACKED },
-{ 0x9d1f505c6ba507bfLL, "Contra", INESB_HACKED },
+{ 0x23214fe456fba2ceLL, "Ganbare Goemon 2", INESB_HACKED },
+{ 0x27da2b0c500dc346LL, "Fire Emblem", INESB_HACKED },
+{ 0x30471e773f7cdc89LL, "Famista 94", INESB_HACKED },
+{ 0x3716c4bebf885344LL, "Super Mario Bros.", INESB_HACKED },
+{ 0x4712856d3e12f21fLL, "Akumajou Densetsu", INESB_HACKED },
+{ 0x500b267abb323005LL, "Dragon Warrior 4", INESB_CORRUPT },
 { 0x60936436d3ea0ab6LL, "Crisis Force", INESB_HACKED },
-{ 0xcf31097ddbb03c5dLL, "Crystalis (Prototype)", INESB_CORRUPT },
-{ 0x92080a8ce94200eaLL, "Digital Devil Story II", INESB_HACKED },
 { 0x6c2a2f95c2fe4b6eLL, "Dragon Ball", INESB_HACKED },
 { 0x767aaff62963c58fLL, "Dragon Ball", INESB_HACKED },
-{ 0x97f133d8bc1c28dbLL, "Dragon Ball", INESB_HACKED },
-{ 0x500b267abb323005LL, "Dragon Warrior 4", INESB_CORRUPT },
-{ 0x02bdcf375704784bLL, "Erika to Satoru no Yume Bouken", INESB_HACKED },
-{ 0xd4fea9d2633b9186LL, "Famista 91", INESB_HACKED },
-{ 0xfdf8c812839b61f0LL, "Famista 92", INESB_HACKED },
-{ 0xb5bb1d0fb47d0850LL, "Famista 93", INESB_HACKED },
-{ 0x30471e773f7cdc89LL, "Famista 94", INESB_HACKED },
 { 0x76c5c44ffb4a0bd7LL, "Fantasy Zone", INESB_HACKED },
-{ 0xb470bfb90e2b1049LL, "Fire Emblem Gaiden", INESB_HACKED },
-{ 0x27da2b0c500dc346LL, "Fire Emblem", INESB_HACKED },
-{ 0x23214fe456fba2ceLL, "Ganbare Goemon 2", INESB_HACKED },
-{ 0xbf8b22524e8329d9LL, "Ganbare Goemon Gaiden", INESB_HACKED },
-{ 0xa97041c3da0134e3LL, "Gegege no Kitarou 2", INESB_INCOMPLETE },
+{ 0x7979dc51da86f19fLL, "110-in-1", INESB_CORRUPT },
 { 0x805db49a86db5449LL, "Goonies", INESB_HACKED },
-{ 0xc5abdaa65ac49b6bLL, "Gradius 2", INESB_HACKED },
-{ 0x04afae4ad480c11cLL, "Gradius 2", INESB_HACKED },
+{ 0x85d2c348a161cdbfLL, "Bio Senshi Dan", INESB_HACKED },
+{ 0x92080a8ce94200eaLL, "Digital Devil Story II", INESB_HACKED },
+{ 0x97f133d8bc1c28dbLL, "Dragon Ball", INESB_HACKED },
 { 0x9b4bad37b5498992LL, "Gradius 2", INESB_HACKED },
+{ 0x9d1f505c6ba507bfLL, "Contra", INESB_HACKED },
+{ 0xa97041c3da0134e3LL, "Gegege no Kitarou 2", INESB_INCOMPLETE },
 { 0xb068d4ac10ef848eLL, "Highway Star", INESB_HACKED },
+{ 0xb470bfb90e2b1049LL, "Fire Emblem Gaiden", INESB_HACKED },
+{ 0xb5bb1d0fb47d0850LL, "Famista 93", INESB_HACKED },
 { 0xbf5175271e5019c3LL, "Kaiketsu Yanchamaru 3", INESB_HACKED },
+{ 0xbf8b22524e8329d9LL, "Ganbare Goemon Gaiden", INESB_HACKED },
+{ 0xc5abdaa65ac49b6bLL, "Gradius 2", INESB_HACKED },
+{ 0xcf31097ddbb03c5dLL, "Crystalis (Prototype)", INESB_CORRUPT },
+{ 0xd4fea9d2633b9186LL, "Famista 91", INESB_HACKED },
+{ 0xe27c48302108d11bLL, "Chibi Maruko Chan", INESB_HACKED },
+{ 0xecf78d8a13a030a6LL, "Ai Sensei no Oshiete", INESB_HACKED },
 { 0xfb4b508a236bbba3LL, "Salamander", INESB_HACKED },
-{ 0x1895afc6eef26c7dLL, "Super Mario Bros.", INESB_HACKED },
-{ 0x3716c4bebf885344LL, "Super Mario Bros.", INESB_HACKED },
+{ 0xfdf8c812839b61f0LL, "Famista 92", INESB_HACKED },
 { 0xfffda4407d80885aLL, "Sweet Home", INESB_CORRUPT },
-{ 0x103fc85d978b861bLL, "Sweet Home", INESB_CORRUPT },
-{ 0x7979dc51da86f19fLL, "110-in-1", INESB_CORRUPT },
-{ 0x001c0bb9c358252aLL, "110-in-1", INESB_CORRUPT },
-{ 0, 0, 0 }
@@ -0,0 +1,32 @@
+	0x012df596e2b31174LL,	/* Final Fantasy 1+2 */
+	0x04a31647de80fdabLL,	/* Legend of Zelda */
+	0x11b69122efe86e8cLL,	/* RPG Jinsei Game */
+	0x1b084107d0878bd0LL,	/* Startropics 2*/
+	0x2b7103b7a27bd72fLL,	/* AD&D Pool of Radiance */
+	0x2db8f5d16c10b925LL,	/* Kyonshiizu 2 */
+	0x2dcf3a98c7937c22LL,	/* DW 2 */
+	0x2ee3417ba8b69706LL,	/* Hydlide 3*/
+	0x498c10dc463cfe95LL,	/* Battle Fleet */
+	0x4a1f5336b86851b6LL,	/* DW */
+	0x5a30da1d9b4af35dLL,	/* Final Fantasy 3 */
+	0x6917ffcaca2d8466LL,	/* Famista '90 */
+	0x6a858da551ba239eLL,	/* Kaijuu Monogatari */
+	0x733026b6b72f2470LL,	/* Dw 3 */
+	0x77b811b2760104b9LL,	/* Mouryou Senki Madara */
+	0x82000965f04a71bbLL,	/* Mirai Shinwa Jarvas */
+	0x836c0ff4f3e06e45LL,	/* Zelda 2 */
+	0x854d7947a3177f57LL,	/* Crystalis */
+	0x8da46db592a1fcf4LL,	/* Faria */
+	0x91a6846d3202e3d6LL,	/* Final Fantasy */
+	0x94b9484862a26cbaLL,	/* Legend of Zelda */
+	0x98e55e09dfcc7533LL,	/* DW 4*/
+	0x9aa1dc16c05e7de5LL,	/* Startropics */
+	0xa40666740b7d22feLL,	/* Mindseeker */
+	0xa70b495314f4d075LL,	/* Ys 3 */
+	0xb0bcc02c843c1b79LL,	/* DW */
+	0xb72ee2337ced5792LL,	/* AD&D Hillsfar */
+	0xc04361e499748382LL,	/* AD&D Heroes of the Lance */
+	0xd63dcc68c2b20adcLL,	/* Final Fantasy J */
+	0xebbce5a54cf3ecc0LL,	/* Justbreed */
+	0xedba17a2c4608d20LL,	/* Final Fantasy */
+	0xf6b359a720549ecdLL,	/* Final Fantasy 2 */
@@ -0,0 +1,113 @@
+/* Sorts the iNES game database tables for binary searching
+ *
+ * ines-correct.h, ines-bad.h and ines-battery.h hold one entry per line, each
+ * starting with its key: a CRC32 or the lower 64 bits of an MD5. ines.cpp
+ * looks them up by binary search and refuses to build if one of them is out of
+ * order, so after adding entries anywhere in a file run
+ *
+ *   gcc -o ines-sortdb ines-sortdb.c && ./ines-sortdb ines-correct.h ines-bad.h ines-battery.h
+ *
+ * Comment lines are moved in front of the entries and blank lines are dropped.
+ * When a key is listed twice the first entry wins, like the old linear scans.
+ */
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+typedef struct
+{
+	unsigned long long key;
+	int order;
+	char *line;
+} ENTRY;
+
+static char **lines;
+static int nlines;
+
+static int IsEntry(const char *s, unsigned long long *key)
+{
+	while(*s == ' ' || *s == '\t') s++;
+	if(*s == '{') s++;
+	while(*s == ' ' || *s == '\t') s++;
+	if(s[0] != '0' || (s[1] != 'x' && s[1] != 'X'))
+		return 0;
+	*key = strtoull(s, 0, 16);
+	return 1;
+}
+
+static int CompareEntries(const void *a, const void *b)
+{
+	const ENTRY *x = (const ENTRY*)a, *y = (const ENTRY*)b;
+	if(x->key != y->key)
+		return x->key < y->key ? -1 : 1;
+	return x->order - y->order;
+}
+
+static int SortFile(const char *fn)
+{
+	char buf[1024];
+	ENTRY *entries;
+	int nentries = 0, x;
+	FILE *fp;
+
+	if(!(fp = fopen(fn, "rb")))
+	{
+		perror(fn);
+		return 0;
+	}
+	nlines = 0;
+	while(fgets(buf, sizeof(buf), fp))
+	{
+		lines = (char**)realloc(lines, (nlines + 1) * sizeof(char*));
+		lines[nlines++] = strdup(buf);
+	}
+	fclose(fp);
+
+	entries = (ENTRY*)malloc((nlines + 1) * sizeof(ENTRY));
+	for(x = 0; x < nlines; x++)
+	{
+		if(IsEntry(lines[x], &entries[nentries].key))
+		{
+			entries[nentries].order = x;
+			entries[nentries].line = lines[x];
+			nentries++;
+		}
+	}
+	qsort(entries, nentries, sizeof(ENTRY), CompareEntries);
+
+	if(!(fp = fopen(fn, "wb")))
+	{
+		perror(fn);
+		return 0;
+	}
+	for(x = 0; x < nlines; x++)
+	{
+		unsigned long long key;
+		if(!IsEntry(lines[x], &key) && strspn(lines[x], " \t\r\n") != strlen(lines[x]))
+			fputs(lines[x], fp);
+	}
+	for(x = 0; x < nentries; x++)
+	{
+		if(x && entries[x].key == entries[x - 1].key)
+		{
+			fprintf(stderr, "%s: dropping duplicate %s", fn, entries[x].line);
+			continue;
+		}
+		fputs(entries[x].line, fp);
+	}
+	fclose(fp);
+
+	for(x = 0; x < nlines; x++)
+		free(lines[x]);
+	free(entries);
+	return 1;
+}
+
+int main(int argc, char *argv[])
+{
+	int x, ok = 1;
+	for(x = 1; x < argc; x++)
+		ok = SortFile(argv[x]) && ok;
+	return ok ? 0 : 1;
+}
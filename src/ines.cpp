@@ -56,6 +56,9 @@ static CartInfo iNESCart;
 uint8 Mirroring = 0;
 uint32 ROM_size = 0;
 uint32 VROM_size = 0;
+
+//ROM and VROM point into one copy-on-write mapping of the image file, this long
+static uint32 iNESMapSize = 0;
 char LoadedRomFName[2048]; //mbg merge 7/17/06 added
 
 static int CHRRAMSize = -1;
@@ -65,6 +68,47 @@ static int MapperNo = 0;
 
 static int iNES2 = 0;
 
+static void iNESFreeROM(void) {
+	if (iNESMapSize) {
+		FCEU_funmap(ROM, iNESMapSize);
+		iNESMapSize = 0;
+	} else {
+		if (ROM)
+			FCEU_gfree(ROM);
+		if (VROM)
+			FCEU_gfree(VROM);
+	}
+	ROM = NULL;
+	VROM = NULL;
+}
+
+//MD5 and CRC32 in one pass: each block goes through both while it is in cache
+static uint32 iNESHash(struct md5_context *md5, uint32 crc, uint8 *buf, uint32 len) {
+	const uint32 block = 0x4000;
+	for (uint32 pos = 0; pos < len; pos += block) {
+		uint32 n = (len - pos < block) ? len - pos : block;
+		md5_update(md5, buf + pos, n);
+		crc = CalcCRC32(crc, buf + pos, n);
+	}
+	return crc;
+}
+
+//Reads len bytes into buf, then hashes size bytes of it, block by block so
+//each block is hashed while it is still in cache. For compressed images the
+//read is where the inflating happens. md5 is NULL when the hash is known.
+static void iNESReadHash(FCEUFILE *fp, uint8 *buf, uint32 len, uint32 size, struct md5_context *md5, uint32 *crc) {
+	const uint32 block = 0x4000;
+	uint32 pos;
+	for (pos = 0; pos < len; pos += block) {
+		uint32 n = (len - pos < block) ? len - pos : block;
+		FCEU_fread(buf + pos, 1, n, fp);
+		if (md5)
+			*crc = iNESHash(md5, *crc, buf + pos, n);
+	}
+	if (md5 && size > len)
+		*crc = iNESHash(md5, *crc, buf + len, size - len);
+}
+
 static DECLFR(TrainerRead) {
 	return(trainerpoo[A & 0x1FF]);
 }
@@ -106,20 +150,13 @@ void iNESGI(GI h) { //bbit edited: removed static keyword
 		FCEU_SaveGameSave(&iNESCart);
 		if (iNESCart.Close)
 			iNESCart.Close();
-		if (ROM) {
-			free(ROM);
-			ROM = NULL;
-		}
-		if (VROM) {
-			free(VROM);
-			VROM = NULL;
-		}
+		iNESFreeROM();
 		if (trainerpoo) {
-			free(trainerpoo);
+			FCEU_gfree(trainerpoo);
 			trainerpoo = NULL;
 		}
 		if (ExtraNTARAM) {
-			free(ExtraNTARAM);
+			FCEU_gfree(ExtraNTARAM);
 			ExtraNTARAM = NULL;
 		}
 	}
@@ -131,7 +168,7 @@ uint32 iNESGameCRC32 = 0;
 
 struct CRCMATCH {
 	uint32 crc;
-	char *name;
+	const char *name;
 };
 
 struct INPSEL {
@@ -232,33 +269,73 @@ static void SetInput(void) {
 
 struct BADINF {
 	uint64 md5partial;
-	char *name;
+	const char *name;
 	uint32 type;
 };
 
-static struct BADINF BadROMImages[] =
-{
-	#include "ines-bad.h"
+struct CHINF {
+	uint32 crc32;
+	int32 mapper;
+	int32 mirror;
+	const char* params;
 };
 
-void CheckBad(uint64 md5partial) {
-	int32 x = 0;
-	while (BadROMImages[x].name) {
-		if (BadROMImages[x].md5partial == md5partial) {
-			FCEU_PrintError("The copy game you have loaded, \"%s\", is bad, and will not work properly in FCEUX.", BadROMImages[x].name);
-			return;
-		}
-		x++;
+/* The game database tables below are kept sorted by ines-sortdb.c and
+binary searched; iNESDBSorted stops the build if one is out of order.
+*/
+static constexpr uint64 iNESDBKey(uint64 md5partial) { return md5partial; }
+static constexpr uint64 iNESDBKey(const BADINF &e) { return e.md5partial; }
+static constexpr uint64 iNESDBKey(const CHINF &e) { return e.crc32; }
+
+template<typename T>
+static constexpr bool iNESDBSorted(const T *t, size_t lo, size_t hi) {
+	return hi - lo < 2 || (iNESDBSorted(t, lo, (lo + hi) / 2)
+		&& iNESDBKey(t[(lo + hi) / 2 - 1]) < iNESDBKey(t[(lo + hi) / 2])
+		&& iNESDBSorted(t, (lo + hi) / 2, hi));
+}
+
+template<typename T>
+static const T *iNESDBFind(const T *t, size_t n, uint64 key) {
+	size_t lo = 0, hi = n;
+	while (lo < hi) {
+		size_t mid = (lo + hi) / 2;
+		if (iNESDBKey(t[mid]) < key)
+			lo = mid + 1;
+		else
+			hi = mid;
 	}
+	return (lo < n && iNESDBKey(t[lo]) == key) ? &t[lo] : NULL;
 }
 
+static constexpr BADINF BadROMImages[] =
+{
+	#include "ines-bad.h"
+};
+static_assert(iNESDBSorted(BadROMImages, 0, ARRAY_SIZE(BadROMImages)), "ines-bad.h is out of order, run ines-sortdb");
 
-struct CHINF {
-	uint32 crc32;
-	int32 mapper;
-	int32 mirror;
-	const char* params;
+/* ROM images that have the battery-backed bit set in the header that really
+don't have battery-backed RAM is not that big of a problem, so I'll
+treat this differently by only listing games that should have battery-backed RAM.
+
+Lower 64 bits of the MD5 hash.
+*/
+static constexpr uint64 savie[] =
+{
+	#include "ines-battery.h"
+};
+static_assert(iNESDBSorted(savie, 0, ARRAY_SIZE(savie)), "ines-battery.h is out of order, run ines-sortdb");
+
+static constexpr CHINF moo[] =
+{
+	#include "ines-correct.h"
 };
+static_assert(iNESDBSorted(moo, 0, ARRAY_SIZE(moo)), "ines-correct.h is out of order, run ines-sortdb");
+
+void CheckBad(uint64 md5partial) {
+	const BADINF *bad = iNESDBFind(BadROMImages, ARRAY_SIZE(BadROMImages), md5partial);
+	if (bad)
+		FCEU_PrintError("The copy game you have loaded, \"%s\", is bad, and will not work properly in FCEUX.", bad->name);
+}
 
 static const TMasterRomInfo sMasterRomInfo[] = {
 	{ 0x62b51b108a01d2beLL, "bonus=0" }, //4-in-1 (FK23C8021)[p1][!].nes
@@ -275,54 +352,6 @@ const TMasterRomInfo* MasterRomInfo;
 TMasterRomInfoParams MasterRomInfoParams;
 
 static void CheckHInfo(void) {
-	/* ROM images that have the battery-backed bit set in the header that really
-	don't have battery-backed RAM is not that big of a problem, so I'll
-	treat this differently by only listing games that should have battery-backed RAM.
-
-	Lower 64 bits of the MD5 hash.
-	*/
-
-	static uint64 savie[] =
-	{
-		0xc04361e499748382LL,	/* AD&D Heroes of the Lance */
-		0xb72ee2337ced5792LL,	/* AD&D Hillsfar */
-		0x2b7103b7a27bd72fLL,	/* AD&D Pool of Radiance */
-		0x498c10dc463cfe95LL,	/* Battle Fleet */
-		0x854d7947a3177f57LL,	/* Crystalis */
-		0x4a1f5336b86851b6LL,	/* DW */
-		0xb0bcc02c843c1b79LL,	/* DW */
-		0x2dcf3a98c7937c22LL,	/* DW 2 */
-		0x98e55e09dfcc7533LL,	/* DW 4*/
-		0x733026b6b72f2470LL,	/* Dw 3 */
-		0x6917ffcaca2d8466LL,	/* Famista '90 */
-		0x8da46db592a1fcf4LL,	/* Faria */
-		0xedba17a2c4608d20LL,	/* Final Fantasy */
-		0x91a6846d3202e3d6LL,	/* Final Fantasy */
-		0x012df596e2b31174LL,	/* Final Fantasy 1+2 */
-		0xf6b359a720549ecdLL,	/* Final Fantasy 2 */
-		0x5a30da1d9b4af35dLL,	/* Final Fantasy 3 */
-		0xd63dcc68c2b20adcLL,	/* Final Fantasy J */
-		0x2ee3417ba8b69706LL,	/* Hydlide 3*/
-		0xebbce5a54cf3ecc0LL,	/* Justbreed */
-		0x6a858da551ba239eLL,	/* Kaijuu Monogatari */
-		0x2db8f5d16c10b925LL,	/* Kyonshiizu 2 */
-		0x04a31647de80fdabLL,	/* Legend of Zelda */
-		0x94b9484862a26cbaLL,	/* Legend of Zelda */
-		0xa40666740b7d22feLL,	/* Mindseeker */
-		0x82000965f04a71bbLL,	/* Mirai Shinwa Jarvas */
-		0x77b811b2760104b9LL,	/* Mouryou Senki Madara */
-		0x11b69122efe86e8cLL,	/* RPG Jinsei Game */
-		0x9aa1dc16c05e7de5LL,	/* Startropics */
-		0x1b084107d0878bd0LL,	/* Startropics 2*/
-		0xa70b495314f4d075LL,	/* Ys 3 */
-		0x836c0ff4f3e06e45LL,	/* Zelda 2 */
-		0						/* Abandon all hope if the game has 0 in the lower 64-bits of its MD5 hash */
-	};
-
-	static struct CHINF moo[] =
-	{
-		#include "ines-correct.h"
-	};
 	int32 tofix = 0, x, mask;
 	uint64 partialmd5 = 0;
 
@@ -347,55 +376,48 @@ static void CheckHInfo(void) {
 		break;
 	}
 
-	x = 0;
-	do {
-		if (moo[x].crc32 == iNESGameCRC32) {
-			if (moo[x].mapper >= 0) {
-				if (moo[x].mapper & 0x800 && VROM_size) {
-					VROM_size = 0;
-					free(VROM);
-					VROM = NULL;
-					tofix |= 8;
-				}
-				if (moo[x].mapper & 0x1000)
-					mask = 0xFFF;
-				else
-					mask = 0xFF;
-				if (MapperNo != (moo[x].mapper & mask)) {
-					tofix |= 1;
-					MapperNo = moo[x].mapper & mask;
-				}
+	const CHINF *fix = iNESDBFind(moo, ARRAY_SIZE(moo), iNESGameCRC32);
+	if (fix) {
+		if (fix->mapper >= 0) {
+			if (fix->mapper & 0x800 && VROM_size) {
+				VROM_size = 0;
+				if (!iNESMapSize)
+					FCEU_gfree(VROM);
+				VROM = NULL;
+				tofix |= 8;
 			}
-			if (moo[x].mirror >= 0) {
-				if (moo[x].mirror == 8) {
-					if (Mirroring == 2) {	/* Anything but hard-wired(four screen). */
-						tofix |= 2;
-						Mirroring = 0;
-					}
-				} else if (Mirroring != moo[x].mirror) {
-					if (Mirroring != (moo[x].mirror & ~4))
-						if ((moo[x].mirror & ~4) <= 2)	/* Don't complain if one-screen mirroring
-														needs to be set(the iNES header can't
-														hold this information).
-														*/
-							tofix |= 2;
-					Mirroring = moo[x].mirror;
-				}
+			if (fix->mapper & 0x1000)
+				mask = 0xFFF;
+			else
+				mask = 0xFF;
+			if (MapperNo != (fix->mapper & mask)) {
+				tofix |= 1;
+				MapperNo = fix->mapper & mask;
 			}
-			break;
 		}
-		x++;
-	} while (moo[x].mirror >= 0 || moo[x].mapper >= 0);
-
-	x = 0;
-	while (savie[x] != 0) {
-		if (savie[x] == partialmd5) {
-			if (!(head.ROM_type & 2)) {
-				tofix |= 4;
-				head.ROM_type |= 2;
+		if (fix->mirror >= 0) {
+			if (fix->mirror == 8) {
+				if (Mirroring == 2) {	/* Anything but hard-wired(four screen). */
+					tofix |= 2;
+					Mirroring = 0;
+				}
+			} else if (Mirroring != fix->mirror) {
+				if (Mirroring != (fix->mirror & ~4))
+					if ((fix->mirror & ~4) <= 2)	/* Don't complain if one-screen mirroring
+													needs to be set(the iNES header can't
+													hold this information).
+													*/
+						tofix |= 2;
+				Mirroring = fix->mirror;
 			}
 		}
-		x++;
+	}
+
+	if (iNESDBFind(savie, ARRAY_SIZE(savie), partialmd5)) {
+		if (!(head.ROM_type & 2)) {
+			tofix |= 4;
+			head.ROM_type |= 2;
+		}
 	}
 
 	/* Games that use these iNES mappers tend to have the four-screen bit set
@@ -416,7 +438,7 @@ static void CheckHInfo(void) {
 		if (tofix & 1)
 			sprintf(gigastr + strlen(gigastr), "The mapper number should be set to %d.  ", MapperNo);
 		if (tofix & 2) {
-			char *mstr[3] = { "Horizontal", "Vertical", "Four-screen" };
+			const char *mstr[3] = { "Horizontal", "Vertical", "Four-screen" };
 			sprintf(gigastr + strlen(gigastr), "Mirroring should be set to \"%s\".  ", mstr[Mirroring & 3]);
 		}
 		if (tofix & 4)
@@ -444,7 +466,7 @@ static int not_power2[] =
 	53, 198, 228
 };
 typedef struct {
-	char *name;
+	const char *name;
 	int32 number;
 	void (*init)(CartInfo *);
 } BMAPPINGLocal;
@@ -780,44 +802,65 @@ int iNESLoad(const char *name, FCEUFILE *fp, int OverwriteVidMode) {
 		}
 	}
 
-	if ((ROM = (uint8*)FCEU_malloc(ROM_size << 14)) == NULL)
-		return 0;
-	memset(ROM, 0xFF, ROM_size << 14);
-
-	if (VROM_size) {
-		if ((VROM = (uint8*)FCEU_malloc(VROM_size << 13)) == NULL) {
-			free(ROM);
-			ROM = NULL;
-			return 0;
-		}
-		memset(VROM, 0xFF, VROM_size << 13);
-	}
-
 	if (head.ROM_type & 4) {	/* Trainer */
 		trainerpoo = (uint8*)FCEU_gmalloc(512);
 		FCEU_fread(trainerpoo, 512, 1, fp);
 	}
 
-	ResetCartMapping();
-	ResetExState(0, 0);
-
-	SetupCartPRGMapping(0, ROM, ROM_size << 14, 0);
+	//a mapped image that is in the cache isn't read at all here
+	bool hashed = FCEU_LookupROMHash(fp, iNESCart.MD5, &iNESGameCRC32);
+	if (!hashed) {
+		md5_starts(&md5);
+		iNESGameCRC32 = 0;
+	}
 
-	FCEU_fread(ROM, 0x4000, (round) ? ROM_size : not_round_size, fp);
+	//serve the banks straight from the file when it holds all of them. The
+	//game then reads the file itself for as long as it runs: rewriting the
+	//.nes meanwhile or losing the card it is on raises SIGBUS (see FCEU_fmap)
+	if (round || (uint32)not_round_size == ROM_size) {
+		uint32 len = (ROM_size << 14) + (VROM_size << 13);
+		if ((ROM = FCEU_fmap(fp, len)) != NULL) {
+			iNESMapSize = len;
+			VROM = VROM_size ? ROM + (ROM_size << 14) : NULL;
+		}
+	}
 
-	if (VROM_size)
-		FCEU_fread(VROM, 0x2000, VROM_size, fp);
+	if (!iNESMapSize) {
+		if ((ROM = (uint8*)FCEU_gtrymalloc(ROM_size << 14)) == NULL)
+			return 0;
+		memset(ROM, 0xFF, ROM_size << 14);
 
-	md5_starts(&md5);
-	md5_update(&md5, ROM, ROM_size << 14);
+		if (VROM_size) {
+			if ((VROM = (uint8*)FCEU_gtrymalloc(VROM_size << 13)) == NULL) {
+				FCEU_gfree(ROM);
+				ROM = NULL;
+				return 0;
+			}
+			memset(VROM, 0xFF, VROM_size << 13);
+		}
 
-	iNESGameCRC32 = CalcCRC32(0, ROM, ROM_size << 14);
+		//zipped and gzipped images inflate straight into these buffers
+		iNESReadHash(fp, ROM, ((round) ? ROM_size : not_round_size) << 14, ROM_size << 14,
+			hashed ? NULL : &md5, &iNESGameCRC32);
+
+		if (VROM_size)
+			iNESReadHash(fp, VROM, VROM_size << 13, VROM_size << 13,
+				hashed ? NULL : &md5, &iNESGameCRC32);
+	} else if (!hashed) {
+		iNESGameCRC32 = iNESHash(&md5, 0, ROM, ROM_size << 14);
+		if (VROM_size)
+			iNESGameCRC32 = iNESHash(&md5, iNESGameCRC32, VROM, VROM_size << 13);
+	}
 
-	if (VROM_size) {
-		iNESGameCRC32 = CalcCRC32(iNESGameCRC32, VROM, VROM_size << 13);
-		md5_update(&md5, VROM, VROM_size << 13);
+	if (!hashed) {
+		md5_finish(&md5, iNESCart.MD5);
+		FCEU_StoreROMHash(fp, iNESCart.MD5, iNESGameCRC32);
 	}
-	md5_finish(&md5, iNESCart.MD5);
+
+	ResetCartMapping();
+	ResetExState(0, 0);
+
+	SetupCartPRGMapping(0, ROM, ROM_size << 14, 0);
 	memcpy(&GameInfo->MD5, &iNESCart.MD5, sizeof(iNESCart.MD5));
 
 	iNESCart.CRC32 = iNESGameCRC32;
@@ -833,7 +876,7 @@ int iNESLoad(const char *name, FCEUFILE *fp, int OverwriteVidMode) {
 		FCEU_printf("\n");
 	}
 
-	char* mappername = "Not Listed";
+	const char* mappername = "Not Listed";
 
 	for (int mappertest = 0; mappertest < (sizeof bmap / sizeof bmap[0]) - 1; mappertest++) {
 		if (bmap[mappertest].number == MapperNo) {
@@ -35,6 +35,8 @@
 #include "vsuni.h"
 #include "fds.h"
 #include "driver.h"
+#include "rewind.h"
+#include "runahead.h"
 
 #if defined(WIN32) && !defined(DINGUX)
 #include "drivers/win/main.h"
@@ -388,7 +390,7 @@ void FCEU_DrawInput(uint8 *buf)
 void FCEU_UpdateInput(void)
 {
 	//tell all drivers to poll input and set up their logical states
-	if(!FCEUMOV_Mode(MOVIEMODE_PLAY))
+	if(!FCEUMOV_Mode(MOVIEMODE_PLAY) && !FCEU_RewindReplaying())
 	{
 		for(int port=0;port<2;port++){
 			joyports[port].driver->Update(port,joyports[port].ptr,joyports[port].attrib);
@@ -403,6 +405,8 @@ void FCEU_UpdateInput(void)
 		NetplayUpdate(joy);
 
 	FCEUMOV_AddInputState();
+	if(!FCEU_RunAheadSpeculating())
+		FCEU_RewindInput();
 
 	//TODO - should this apply to the movie data? should this be displayed in the input hud?
 	if(GameInfo->type==GIT_VSUNI){
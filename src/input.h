@@ -284,7 +284,7 @@ struct EMUCMDTABLE
 	EMUCMDFN* fn_on;
 	EMUCMDFN* fn_off;
 	int state;
-	char* name;
+	const char* name;
 	int flags; //EMUCMDFLAG
 };
 
@@ -2376,9 +2376,15 @@ static int zapper_read(lua_State *L){
 		else
 			z = currFrameCounter -1;
 
-		x = currMovieData.records[z].zappers[1].x;	//adelikat:  Used hardcoded port 1 since as far as I know, only port 1 is valid for zappers
-		y = currMovieData.records[z].zappers[1].y;
-		click = currMovieData.records[z].zappers[1].b;
+		if (FCEUMOV_FetchRecord(z))
+		{
+			MovieRecord mr = currMovieData.records.get(z);
+			x = mr.zappers[1].x;	//adelikat:  Used hardcoded port 1 since as far as I know, only port 1 is valid for zappers
+			y = mr.zappers[1].y;
+			click = mr.zappers[1].b;
+		}
+		else
+			x = y = click = 0;
 	}
 	else
 	{
@@ -13,6 +13,7 @@
 #include "movie.h"
 #include "fds.h"
 #include "vsuni.h"
+#include "moviecache.h"
 #ifdef _S9XLUA_H
 #include "fceulua.h"
 #endif
@@ -109,9 +110,10 @@ char lagcounterbuf[32] = {0};
 
 void MovieData::clearRecordRange(int start, int len)
 {
+	MovieRecord empty;
 	for(int i=0;i<len;i++)
 	{
-		records[i+start].clear();
+		records.set(i+start, empty);
 	}
 }
 
@@ -119,17 +121,9 @@ void MovieData::eraseRecords(int at, int frames)
 {
 	if (at < (int)records.size())
 	{
-		if (frames == 1)
-		{
-			// erase 1 frame
-			records.erase(records.begin() + at);
-		} else
-		{
-			// erase many frames
-			if (at + frames > (int)records.size())
-				frames = (int)records.size() - at;
-			records.erase(records.begin() + at, records.begin() + (at + frames));
-		}
+		if (at + frames > (int)records.size())
+			frames = (int)records.size() - at;
+		records.erase(at, frames);
 	}
 }
 
@@ -140,7 +134,7 @@ void MovieData::insertEmpty(int at, int frames)
 		records.resize(records.size() + frames);
 	} else
 	{
-		records.insert(records.begin() + at, frames, MovieRecord());
+		records.insert(at, frames);
 	}
 }
 
@@ -148,10 +142,120 @@ void MovieData::cloneRegion(int at, int frames)
 {
 	if (at < 0) return;
 
-	records.insert(records.begin() + at, frames, MovieRecord());
+	records.insert(at, frames);
 
 	for(int i = 0; i < frames; i++)
-		records[i + at].Clone(records[i + at + frames]);
+		records.set(i + at, records.get(i + at + frames));
+}
+// ----------------------------------------------------------------------------
+void MovieRecordList::clear()
+{
+	joysticks.clear();
+	commands.clear();
+	zappers.clear();
+}
+
+void MovieRecordList::resize(int frames)
+{
+	if (frames < size())
+	{
+		commands.truncate(frames);
+		zappers.truncate(frames);
+	}
+	joysticks.resize(frames * 4, 0);
+}
+
+void MovieRecordList::insert(int at, int frames)
+{
+	joysticks.insert(joysticks.begin() + at * 4, frames * 4, 0);
+	commands.insert(at, frames);
+	zappers.insert(at, frames);
+}
+
+void MovieRecordList::erase(int at, int frames)
+{
+	joysticks.erase(joysticks.begin() + at * 4, joysticks.begin() + (at + frames) * 4);
+	commands.erase(at, frames);
+	zappers.erase(at, frames);
+}
+
+void MovieRecordList::push_back(const MovieRecord& mr)
+{
+	joysticks.resize(joysticks.size() + 4);
+	set(size() - 1, mr);
+}
+
+static bool ZapperUsed(const MovieRecord::ZAPPER& z)
+{
+	return z.x || z.y || z.b || z.bogo || z.zaphit;
+}
+
+MovieRecord MovieRecordList::get(int frame) const
+{
+	MovieRecord mr;
+	memcpy(&mr.joysticks, &joysticks[frame * 4], 4);
+	if (const uint8* c = commands.find(frame))
+		mr.commands = *c;
+	if (const ZAPPERS* z = zappers.find(frame))
+		memcpy(mr.zappers, z->zappers, sizeof(mr.zappers));
+	return mr;
+}
+
+void MovieRecordList::set(int frame, const MovieRecord& mr)
+{
+	memcpy(&joysticks[frame * 4], &mr.joysticks, 4);
+
+	if (mr.commands)
+		commands.set(frame, mr.commands);
+	else
+		commands.remove(frame);
+
+	if (ZapperUsed(mr.zappers[0]) || ZapperUsed(mr.zappers[1]))
+	{
+		ZAPPERS z;
+		memcpy(z.zappers, mr.zappers, sizeof(z.zappers));
+		zappers.set(frame, z);
+	} else
+		zappers.remove(frame);
+}
+
+MovieRecordRef::MovieRecordRef(MovieRecordList& list, int frame)
+	: joysticks(&list.joysticks[frame * 4])
+	, commands(list, frame)
+	, list(list)
+	, frame(frame)
+{
+}
+
+MovieRecordRef::COMMANDS::operator uint8() const
+{
+	const uint8* c = list.commands.find(frame);
+	return c ? *c : 0;
+}
+
+MovieRecordRef::COMMANDS& MovieRecordRef::COMMANDS::operator=(uint8 val)
+{
+	if (val)
+		list.commands.set(frame, val);
+	else
+		list.commands.remove(frame);
+	return *this;
+}
+
+void MovieRecordRef::clear()
+{
+	list.set(frame, MovieRecord());
+}
+
+MovieRecordRef::operator MovieRecord() const
+{
+	return list.get(frame);
+}
+
+MovieRecordRef& MovieRecordRef::operator=(const MovieRecord& mr)
+{
+	list.set(frame, mr);
+	return *this;
 }
 // ----------------------------------------------------------------------------
 MovieRecord::MovieRecord()
@@ -496,11 +600,11 @@ int MovieData::dump(EMUFILE *os, bool binary)
 		//put one | to start the binary dump
 		os->fputc('|');
 		for(int i=0;i<(int)records.size();i++)
-			records[i].dumpBinary(this, os, i);
+			records.get(i).dumpBinary(this, os, i);
 	} else
 	{
 		for(int i=0;i<(int)records.size();i++)
-			records[i].dump(this, os, i);
+			records.get(i).dump(this, os, i);
 	}
 
 	int end = os->ftell();
@@ -557,7 +661,7 @@ bool FCEUMOV_Mode(int modemask)
 	return FCEUMOV_Mode((EMOVIEMODE)modemask);
 }
 
-static void LoadFM2_binarychunk(MovieData& movieData, EMUFILE* fp, int size)
+static int FM2_recordsize(MovieData& movieData)
 {
 	int recordsize = 1; //1 for the command
 	if(movieData.fourscore)
@@ -573,7 +677,12 @@ static void LoadFM2_binarychunk(MovieData& movieData, EMUFILE* fp, int size)
 			}
 		}
 	}
+	return recordsize;
+}
 
+//number of binary records starting at the current position
+static int FM2_binaryrecords(MovieData& movieData, EMUFILE* fp, int size, int recordsize)
+{
 	//find out how much remains in the file
 	int curr = fp->ftell();
 	fp->fseek(0,SEEK_END);
@@ -587,16 +696,26 @@ static void LoadFM2_binarychunk(MovieData& movieData, EMUFILE* fp, int size)
 	int numRecords = todo/recordsize;
 	if (movieData.loadFrameCount!=-1 && movieData.loadFrameCount<numRecords)
 		numRecords=movieData.loadFrameCount;
+	return numRecords;
+}
+
+static void LoadFM2_binarychunk(MovieData& movieData, EMUFILE* fp, int size)
+{
+	int numRecords = FM2_binaryrecords(movieData, fp, size, FM2_recordsize(movieData));
 
-	movieData.records.resize(numRecords);
+	movieData.records.reserve(numRecords);
 	for(int i=0;i<numRecords;i++)
 	{
-		movieData.records[i].parseBinary(&movieData,fp);
+		MovieRecord mr;
+		mr.parseBinary(&movieData,fp);
+		movieData.records.push_back(mr);
 	}
 }
 
 //yuck... another custom text parser.
-bool LoadFM2(MovieData& movieData, EMUFILE* fp, int size, bool stopAfterHeader)
+//if stoppedAtInput is given, parsing stops right after the '|' that starts the
+//first record and reports whether it got there; size is left at what remains.
+static bool ParseFM2(MovieData& movieData, EMUFILE* fp, int& size, bool stopAfterHeader, bool* stoppedAtInput)
 {
 	// if there's no "binary" tag in the movie header, consider it as a movie in text format
 	movieData.binaryFlag = false;
@@ -644,6 +763,11 @@ bool LoadFM2(MovieData& movieData, EMUFILE* fp, int size, bool stopAfterHeader)
 		isnewline = (c==10||c==13);
 		if(isrecchar && movieData.binaryFlag && !stopAfterHeader)
 		{
+			if(stoppedAtInput)
+			{
+				*stoppedAtInput = true;
+				return true;
+			}
 			LoadFM2_binarychunk(movieData, fp, size);
 			return true;
 		} else if (isnewline && movieData.loadFrameCount == movieData.records.size())
@@ -665,12 +789,17 @@ bool LoadFM2(MovieData& movieData, EMUFILE* fp, int size, bool stopAfterHeader)
 			{
 				dorecord:
 				if (stopAfterHeader) return true;
-				int currcount = movieData.records.size();
-				movieData.records.resize(currcount+1);
+				if (stoppedAtInput)
+				{
+					*stoppedAtInput = true;
+					return true;
+				}
+				MovieRecord mr;
 				int preparse = fp->ftell();
-				movieData.records[currcount].parse(&movieData, fp);
+				mr.parse(&movieData, fp);
 				int postparse = fp->ftell();
 				size -= (postparse-preparse);
+				movieData.records.push_back(mr);
 				state = NEWLINE;
 				break;
 			}
@@ -710,11 +839,143 @@ bool LoadFM2(MovieData& movieData, EMUFILE* fp, int size, bool stopAfterHeader)
 	return true;
 }
 
+bool LoadFM2(MovieData& movieData, EMUFILE* fp, int size, bool stopAfterHeader)
+{
+	return ParseFM2(movieData, fp, size, stopAfterHeader, NULL);
+}
+
+//The input of the movie being played back, read from its file as playback
+//reaches it. A long movie starts at once and only the frames played so far
+//take memory. Only currMovieData is ever streamed.
+struct MOVIESTREAM
+{
+	FCEUFILE* fp;
+	int left;			//bytes of the movie not read yet
+	int recordsize;		//binary movies; 0 for text, where each record follows its '|'
+	int total;			//records in the whole movie, -1 until known
+};
+static MOVIESTREAM* playbackStream = NULL;
+
+static void closePlaybackStream()
+{
+	if(playbackStream)
+	{
+		delete playbackStream->fp;
+		delete playbackStream;
+		playbackStream = NULL;
+	}
+}
+
+static void openPlaybackStream(FCEUFILE* fp, int left)
+{
+	closePlaybackStream();
+	playbackStream = new MOVIESTREAM();
+	playbackStream->fp = fp;
+	playbackStream->left = left;
+	if(currMovieData.binaryFlag)
+	{
+		playbackStream->recordsize = FM2_recordsize(currMovieData);
+		playbackStream->total = FM2_binaryrecords(currMovieData, fp->stream, left, playbackStream->recordsize);
+	} else
+	{
+		playbackStream->recordsize = 0;
+		playbackStream->total = currMovieData.loadFrameCount == 0 ? 0 : -1;
+	}
+	if(playbackStream->total == 0)
+		closePlaybackStream();
+}
+
+//moves a text stream past the '|' that starts the next record; false at the end
+static bool seekNextRecord(EMUFILE* is, int& left)
+{
+	bool linestart = false;
+	for(;;)
+	{
+		if(left--<=0) return false;
+		int c = is->fgetc();
+		if(c == -1) return false;
+		if(c==10||c==13)
+			linestart = true;
+		else if(c=='|' && linestart)
+			return true;
+		else if(c!=' ' && c!='\t')
+			linestart = false;
+	}
+}
+
+//parses one more record of the stream into currMovieData
+static void readStreamRecord()
+{
+	MOVIESTREAM& s = *playbackStream;
+	EMUFILE* is = s.fp->stream;
+	MovieRecord mr;
+	bool more;
+
+	if(s.recordsize)
+	{
+		mr.parseBinary(&currMovieData, is);
+		currMovieData.records.push_back(mr);
+		more = currMovieData.records.size() < s.total;
+	} else
+	{
+		int preparse = is->ftell();
+		mr.parse(&currMovieData, is);
+		s.left -= is->ftell() - preparse;
+		currMovieData.records.push_back(mr);
+		more = currMovieData.records.size() != currMovieData.loadFrameCount && seekNextRecord(is, s.left);
+	}
+
+	if(!more)
+		closePlaybackStream();
+}
+
+//Makes sure currMovieData holds <frame>, reading ahead in the movie file as
+//needed. Returns false if the movie is shorter than that.
+static bool FetchRecord(int frame)
+{
+	while(frame >= currMovieData.records.size() && playbackStream)
+		readStreamRecord();
+	return frame < currMovieData.records.size();
+}
+
+bool FCEUMOV_FetchRecord(int frame)
+{
+	return FetchRecord(frame);
+}
+
+static void FetchAllRecords()
+{
+	while(playbackStream)
+		readStreamRecord();
+}
+
+//length of the current movie, including input not read yet
+static int MovieLength()
+{
+	if(!playbackStream)
+		return currMovieData.records.size();
+
+	MOVIESTREAM& s = *playbackStream;
+	if(s.total < 0)
+	{
+		//count the rest without parsing or keeping it
+		EMUFILE* is = s.fp->stream;
+		int pos = is->ftell();
+		int left = s.left;
+		s.total = currMovieData.records.size() + 1;
+		while(s.total != currMovieData.loadFrameCount && seekNextRecord(is, left))
+			s.total++;
+		is->fseek(pos, SEEK_SET);
+	}
+	return s.total;
+}
+
 /// Stop movie playback.
 static void StopPlayback()
 {
 	FCEU_DispMessageOnMovie("Movie playback stopped.");
 	movieMode = MOVIEMODE_INACTIVE;
+	closePlaybackStream();
 }
 
 // Stop movie playback without closing the movie.
@@ -757,6 +1018,7 @@ void FCEUI_StopMovie()
 		StopPlayback();
 	else if(movieMode == MOVIEMODE_RECORD)
 		StopRecording();
+	FCEUMOV_CacheReset();
 
 	curMovieFilename[0] = 0;			//No longer a current movie filename
 	freshMovie = false;					//No longer a fresh movie loaded
@@ -798,6 +1060,7 @@ void poweron(bool shouldDisableBatteryLoading)
 
 void FCEUMOV_CreateCleanMovie()
 {
+	closePlaybackStream();
 	currMovieData = MovieData();
 	currMovieData.palFlag = FCEUI_GetCurrentVidSystem(0,0)!=0;
 	currMovieData.romFilename = FileBase;
@@ -848,6 +1111,7 @@ bool FCEUI_LoadMovie(const char *fname, bool _read_only, int _pauseframe)
 		StopRecording();
 	//--------------
 
+	closePlaybackStream();
 	currMovieData = MovieData();
 
 	strcpy(curMovieFilename, fname);
@@ -870,9 +1134,15 @@ bool FCEUI_LoadMovie(const char *fname, bool _read_only, int _pauseframe)
 	AddRecentMovieFile(name.c_str());
 #endif
 
-	LoadFM2(currMovieData, fp->stream, fp->size, false);
+	//only the header is read here; the input follows as it is played
+	bool atInput = false;
+	int size = fp->size;
+	ParseFM2(currMovieData, fp->stream, size, false, &atInput);
 	LoadSubtitles(currMovieData);
-	delete fp;
+	if(atInput)
+		openPlaybackStream(fp, size);
+	else
+		delete fp;
 
 	freshMovie = true;	//Movie has been loaded, so it must be unaltered
 	if (bindSavestate) AutoSS = false;	//If bind savestate to movie is true, then their isn't a valid auto-save to load, so flag it
@@ -900,6 +1170,7 @@ bool FCEUI_LoadMovie(const char *fname, bool _read_only, int _pauseframe)
 	FCEUD_SetInput(currMovieData.fourscore, currMovieData.microphone, (ESI)currMovieData.ports[0], (ESI)currMovieData.ports[1], (ESIFC)currMovieData.ports[2]);
 
 	//stuff that should only happen when we're ready to positively commit to the replay
+	FCEUMOV_CacheReset();
 	currFrameCounter = 0;
 	pauseframe = _pauseframe;
 	movie_readonly = _read_only;
@@ -977,6 +1248,7 @@ void FCEUI_SaveMovie(const char *fname, EMOVIE_FLAG flags, std::wstring author)
 
 	//we are going to go ahead and dump the header. from now on we will only be appending frames
 	currMovieData.dump(osRecordingMovie, false);
+	FCEUMOV_CacheReset();
 
 	movieMode = MOVIEMODE_RECORD;
 	movie_readonly = false;
@@ -998,13 +1270,15 @@ void FCEUMOV_AddInputState()
 		if (((int)currMovieData.records.size() - 1) < (currFrameCounter + 1))
 			currMovieData.insertEmpty(-1, (currFrameCounter + 1) - ((int)currMovieData.records.size() - 1));
 
-		MovieRecord* mr = &currMovieData.records[currFrameCounter];
+		MovieRecord rec = currMovieData.records.get(currFrameCounter);
+		MovieRecord* mr = &rec;
 		if (isTaseditorRecording())
 		{
 			// record commands and buttons
 			mr->commands |= _currCommand;
 			joyports[0].log(mr);
 			joyports[1].log(mr);
+			currMovieData.records.set(currFrameCounter, rec);
 			recordInputByTaseditor();
 		}
 		// replay buttons
@@ -1027,7 +1301,7 @@ void FCEUMOV_AddInputState()
 	if (movieMode == MOVIEMODE_PLAY)
 	{
 		//stop when we run out of frames
-		if (currFrameCounter >= (int)currMovieData.records.size())
+		if (!FetchRecord(currFrameCounter))
 		{
 			FinishPlayback();
 			//tell all drivers to poll input and set up their logical states
@@ -1036,7 +1310,8 @@ void FCEUMOV_AddInputState()
 			portFC.driver->Update(portFC.ptr,portFC.attrib);
 		} else
 		{
-			MovieRecord* mr = &currMovieData.records[currFrameCounter];
+			MovieRecord rec = currMovieData.records.get(currFrameCounter);
+			MovieRecord* mr = &rec;
 
 			//reset and power cycle if necessary
 			if(mr->command_power())
@@ -1055,7 +1330,7 @@ void FCEUMOV_AddInputState()
 		}
 
 		//if we are on the last frame, then pause the emulator if the player requested it
-		if (currFrameCounter == currMovieData.records.size()-1)
+		if (FetchRecord(currFrameCounter) && !FetchRecord(currFrameCounter+1))
 		{
 			if(FCEUD_PauseAfterPlayback())
 			{
@@ -1125,12 +1400,12 @@ void FCEU_DrawMovies(uint8 *XBuf)
 		char counterbuf[32] = {0};
 		int color = 0x20;
 		if(movieMode == MOVIEMODE_PLAY)
-			sprintf(counterbuf,"%d/%d",currFrameCounter,(int)currMovieData.records.size());
+			sprintf(counterbuf,"%d/%d",currFrameCounter,MovieLength());
 		else if(movieMode == MOVIEMODE_RECORD)
 			sprintf(counterbuf,"%d",currFrameCounter);
 		else if (movieMode == MOVIEMODE_FINISHED)
 		{
-			sprintf(counterbuf,"%d/%d (finished)",currFrameCounter,(int)currMovieData.records.size());
+			sprintf(counterbuf,"%d/%d (finished)",currFrameCounter,MovieLength());
 			color = 0x17; //Show red to get attention
 		} else if(movieMode == MOVIEMODE_TASEDITOR)
 		{
@@ -1167,7 +1442,11 @@ int FCEUMOV_WriteState(EMUFILE* os)
 {
 	//we are supposed to dump the movie data into the savestate
 	if(movieMode == MOVIEMODE_RECORD || movieMode == MOVIEMODE_PLAY || movieMode == MOVIEMODE_FINISHED)
+	{
+		//the savestate carries the whole movie
+		FetchAllRecords();
 		return currMovieData.dump(os, true);
+	}
 	else return 0;
 }
 
@@ -1183,7 +1462,9 @@ int CheckTimelines(MovieData& stateMovie, MovieData& currMovie)
 
 	for (int x = 0; x < end_frame; x++)
 	{
-		if (!stateMovie.records[x].Compare(currMovie.records[x]))
+		MovieRecord stateRecord = stateMovie.records.get(x);
+		MovieRecord currRecord = currMovie.records.get(x);
+		if (!stateRecord.Compare(currRecord))
 			return x;
 	}
 	// no mismatch found
@@ -1321,6 +1602,7 @@ bool FCEUMOV_ReadState(EMUFILE* is, uint32 size)
 		if (movie_readonly)
 		{
 			// currFrameCounter at this point represents the savestate framecount
+			FetchRecord(std::min(currFrameCounter, (int)tempMovieData.records.size()) - 1);
 			int frame_of_mismatch = CheckTimelines(tempMovieData, currMovieData);
 			if (frame_of_mismatch >= 0)
 			{
@@ -1333,22 +1615,22 @@ bool FCEUMOV_ReadState(EMUFILE* is, uint32 size)
 					FCEU_PrintError("Error: Savestate not in the same timeline as movie!\nFrame %d branches from current timeline", frame_of_mismatch);
 				return false;
 			} else if (movieMode == MOVIEMODE_FINISHED
-				&& currFrameCounter > (int)currMovieData.records.size()
-				&& currMovieData.records.size() == tempMovieData.records.size())
+				&& currFrameCounter > MovieLength()
+				&& MovieLength() == tempMovieData.records.size())
 			{
 				// special case (in MOVIEMODE_FINISHED mode)
 				// allow loading post-movie savestates that were made after finishing current movie
 
-			} else if (currFrameCounter > (int)currMovieData.records.size())
+			} else if (currFrameCounter > MovieLength())
 			{
 				// this is future event state, don't allow it
 				//TODO: turn frame counter to red to get attention
 				if (!backupSavestates)	//If backups are disabled we can just resume normally since we can't restore so stop movie and inform user
 				{
-					FCEU_PrintError("Error: Savestate is from a frame (%d) after the final frame in the movie (%d). This is not permitted.\nUnable to restore backup, movie playback stopped.", currFrameCounter, currMovieData.records.size()-1);
+					FCEU_PrintError("Error: Savestate is from a frame (%d) after the final frame in the movie (%d). This is not permitted.\nUnable to restore backup, movie playback stopped.", currFrameCounter, MovieLength()-1);
 					FCEUI_StopMovie();
 				} else
-					FCEU_PrintError("Savestate is from a frame (%d) after the final frame in the movie (%d). This is not permitted.", currFrameCounter, currMovieData.records.size()-1);
+					FCEU_PrintError("Savestate is from a frame (%d) after the final frame in the movie (%d). This is not permitted.", currFrameCounter, MovieLength()-1);
 				return false;
 			} else if (currFrameCounter > (int)tempMovieData.records.size())
 			{
@@ -1373,6 +1655,8 @@ bool FCEUMOV_ReadState(EMUFILE* is, uint32 size)
 			{
 				//This is a post movie savestate, handle it differently
 				//Replace movie contents but then switch to movie finished mode
+				closePlaybackStream();
+				FCEUMOV_CacheReset();
 				currMovieData = tempMovieData;
 				openRecordingMovie(curMovieFilename);
 				currMovieData.dump(osRecordingMovie, false/*currMovieData.binaryFlag*/);
@@ -1384,6 +1668,8 @@ bool FCEUMOV_ReadState(EMUFILE* is, uint32 size)
 					//we can only assume this here since we have checked that the frame counter is not greater than the movie data
 					tempMovieData.truncateAt(currFrameCounter);
 				
+				closePlaybackStream();
+				FCEUMOV_CacheReset();
 				currMovieData = tempMovieData;
 				FCEUMOV_IncrementRerecordCount();
 				openRecordingMovie(curMovieFilename);
@@ -1461,7 +1747,67 @@ void FCEUI_ToggleInputDisplay(void)
 
 int FCEUI_GetMovieLength()
 {
-	return currMovieData.records.size();
+	return MovieLength();
+}
+
+bool FCEUMOV_SeekTo(int frame)
+{
+	if(!FCEUMOV_IsLoaded())
+		return false;
+
+	int length = MovieLength();
+	if(frame > length) frame = length;
+	if(frame < 0) frame = 0;
+
+	//emulate at least the last frame so there is a picture of it
+	int from = frame > 0 ? frame - 1 : 0;
+	int cached = FCEUMOV_CacheFind(from);
+	bool restore = currFrameCounter > from || cached > currFrameCounter;
+	//without a cached state only a power-on movie can start over
+	if(restore && cached < 0 && !currMovieData.savestate.empty())
+		return false;
+
+	//input after this point is replayed, not overwritten
+	if(movieMode == MOVIEMODE_RECORD)
+	{
+		movie_readonly = true;
+		FCEU_DispMessage("Movie is now Read-Only.",0);
+	}
+	movieMode = MOVIEMODE_PLAY;
+
+	if(restore)
+	{
+		//the raw snapshots carry the frame and lag counters, but the cache
+		//says which frame it went back to, and that is the one to trust
+		int restored = FCEUMOV_CacheRestore(from);
+		if(restored >= 0)
+			currFrameCounter = restored;
+		else
+		{
+			if(!currMovieData.savestate.empty())
+				return false;
+			poweron(true);
+			currFrameCounter = 0;
+		}
+	}
+
+	int paused = EmulationPaused;
+	EmulationPaused = 0;
+	uint8 *gfx;
+	int32 *sound;
+	int32 ssize;
+	while(currFrameCounter < frame && movieMode == MOVIEMODE_PLAY)
+	{
+		int before = currFrameCounter;
+		FCEUI_Emulate(&gfx, &sound, &ssize, currFrameCounter == frame - 1 ? 3 : 2);
+		if(currFrameCounter == before)
+			break;
+		//the movie may have asked for a pause on the way
+		EmulationPaused = 0;
+	}
+	EmulationPaused = paused;
+
+	return currFrameCounter == frame;
 }
 
 int FCEUI_GetMovieRerecordCount()
@@ -1619,7 +1965,7 @@ void ProcessSubtitles(void)
 	}
 }
 
-void FCEU_DisplaySubtitles(char *format, ...)
+void FCEU_DisplaySubtitles(const char *format, ...)
 {
 	va_list ap;
 
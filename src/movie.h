@@ -7,6 +7,7 @@
 
 #include <vector>
 #include <map>
+#include <algorithm>
 #include <string>
 #include <ostream>
 #include <cstdlib>
@@ -81,6 +82,13 @@ inline bool FCEUMOV_IsLoaded() { return (FCEUMOV_Mode(MOVIEMODE_PLAY|MOVIEMODE_R
 
 bool FCEUMOV_ShouldPause(void);
 int FCEUMOV_GetFrame(void);
+//A movie being played is read from its file as it goes: call this before
+//looking at currMovieData.records[frame]. False if the movie is shorter.
+bool FCEUMOV_FetchRecord(int frame);
+//Moves a loaded movie to <frame> from the nearest cached state, emulating the
+//frames in between without drawing them. A movie being recorded switches to
+//read-only playback. Returns false if there is no way to get there.
+bool FCEUMOV_SeekTo(int frame);
 int FCEUI_GetLagCount(void);
 bool FCEUI_GetLagged(void);
 void FCEUI_SetLagFlag(bool value);
@@ -104,7 +112,7 @@ public:
 	MovieRecord();
 	ValueArray<uint8,4> joysticks;
 
-	struct {
+	struct ZAPPER {
 		uint8 x,y,b,bogo;
 		uint64 zaphit;
 	} zappers[2];
@@ -162,6 +170,148 @@ private:
 	int mask(int bit) { return 1<<bit; }
 };
 
+//Values that only a few frames of a movie have, kept sorted by frame
+template<typename T>
+class MovieSideTable
+{
+public:
+	//returns NULL if <frame> has no value
+	const T* find(int frame) const
+	{
+		typename std::vector<ENTRY>::const_iterator it = lower(frame);
+		if(it == entries.end() || it->frame != frame) return 0;
+		return &it->val;
+	}
+	void set(int frame, const T& val)
+	{
+		typename std::vector<ENTRY>::iterator it = lower(frame);
+		if(it != entries.end() && it->frame == frame)
+			it->val = val;
+		else
+		{
+			ENTRY e = { frame, val };
+			entries.insert(it, e);
+		}
+	}
+	void remove(int frame)
+	{
+		typename std::vector<ENTRY>::iterator it = lower(frame);
+		if(it != entries.end() && it->frame == frame)
+			entries.erase(it);
+	}
+	void clear() { entries.clear(); }
+	//drops the values of frames <frames> and later
+	void truncate(int frames) { entries.erase(lower(frames), entries.end()); }
+	//makes room for <frames> frames without values at <at>
+	void insert(int at, int frames)
+	{
+		for(typename std::vector<ENTRY>::iterator it = lower(at); it != entries.end(); ++it)
+			it->frame += frames;
+	}
+	//removes frames <at> to <at>+<frames>-1
+	void erase(int at, int frames)
+	{
+		typename std::vector<ENTRY>::iterator first = lower(at);
+		typename std::vector<ENTRY>::iterator last = entries.erase(first, lower(at + frames));
+		for(; last != entries.end(); ++last)
+			last->frame -= frames;
+	}
+
+private:
+	struct ENTRY
+	{
+		int frame;
+		T val;
+		bool operator<(int f) const { return frame < f; }
+	};
+	std::vector<ENTRY> entries;
+
+	typename std::vector<ENTRY>::iterator lower(int frame) { return std::lower_bound(entries.begin(), entries.end(), frame); }
+	typename std::vector<ENTRY>::const_iterator lower(int frame) const { return std::lower_bound(entries.begin(), entries.end(), frame); }
+};
+
+class MovieRecordList;
+
+//What MovieRecordList::operator[] returns, for code written against the old
+//std::vector<MovieRecord> (the Windows TAS editor): the joypad bytes are
+//edited in place in their column, the commands through the side table.
+class MovieRecordRef
+{
+public:
+	class COMMANDS
+	{
+	public:
+		operator uint8() const;
+		COMMANDS& operator=(uint8 val);
+
+	private:
+		friend class MovieRecordRef;
+		COMMANDS(MovieRecordList& list, int frame) : list(list), frame(frame) {}
+		MovieRecordList& list;
+		int frame;
+	};
+
+	uint8* joysticks;	//the frame's four bytes in the joypad column
+	COMMANDS commands;
+
+	void toggleBit(int joy, int bit) { joysticks[joy] ^= 1<<bit; }
+	void setBit(int joy, int bit) { joysticks[joy] |= 1<<bit; }
+	void clearBit(int joy, int bit) { joysticks[joy] &= ~(1<<bit); }
+	void setBitValue(int joy, int bit, bool val)
+	{
+		if(val) setBit(joy,bit);
+		else clearBit(joy,bit);
+	}
+	bool checkBit(int joy, int bit) const { return (joysticks[joy] & (1<<bit))!=0; }
+	void clear();
+
+	operator MovieRecord() const;
+	MovieRecordRef& operator=(const MovieRecord& mr);
+	MovieRecordRef& operator=(const MovieRecordRef& other) { return *this = (MovieRecord)other; }
+
+private:
+	friend class MovieRecordList;
+	MovieRecordRef(MovieRecordList& list, int frame);
+	MovieRecordList& list;
+	int frame;
+};
+
+//The input of a whole movie, stored by column: the four joypad bytes of every
+//frame packed together (4 bytes a frame instead of a 40 byte MovieRecord),
+//and commands and zapper data, which most frames don't have, in side tables.
+class MovieRecordList
+{
+public:
+	int size() const { return (int)joysticks.size() / 4; }
+	bool empty() const { return joysticks.empty(); }
+	void clear();
+	void reserve(int frames) { joysticks.reserve(frames * 4); }
+	//frames added by these are empty
+	void resize(int frames);
+	void insert(int at, int frames);
+	void erase(int at, int frames);
+	void push_back(const MovieRecord& mr);
+
+	MovieRecord get(int frame) const;
+	void set(int frame, const MovieRecord& mr);
+	uint8 joystick(int frame, int port) const { return joysticks[frame * 4 + port]; }
+
+	//the frame as if the records were still a vector of MovieRecords;
+	//valid until frames are added or removed
+	MovieRecordRef operator[](int frame) { return MovieRecordRef(*this, frame); }
+	MovieRecord operator[](int frame) const { return get(frame); }
+
+private:
+	friend class MovieRecordRef;
+	friend class MovieRecordRef::COMMANDS;
+
+	struct ZAPPERS { MovieRecord::ZAPPER zappers[2]; };
+
+	std::vector<uint8> joysticks;
+	MovieSideTable<uint8> commands;
+	MovieSideTable<ZAPPERS> zappers;
+};
+
 class MovieData
 {
 public:
@@ -177,7 +327,7 @@ public:
 	MD5DATA romChecksum;
 	std::string romFilename;
 	std::vector<uint8> savestate;
-	std::vector<MovieRecord> records;
+	MovieRecordList records;
 	std::vector<std::wstring> comments;
 	std::vector<std::string> subtitles;
 	//this is the RERECORD COUNT. please rename variable.
@@ -279,7 +429,7 @@ void FCEUI_ToggleInputDisplay(void);
 
 void LoadSubtitles(MovieData &);
 void ProcessSubtitles(void);
-void FCEU_DisplaySubtitles(char *format, ...);
+void FCEU_DisplaySubtitles(const char *format, ...);
 
 void poweron(bool shouldDisableBatteryLoading);
 
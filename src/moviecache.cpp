@@ -0,0 +1,220 @@
+/* FCE Ultra - NES/Famicom Emulator
+ *
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation; either version 2 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 675 Mass Ave, Cambridge, MA 02139, USA.
+ */
+
+// Movie state cache.
+// While a movie is played or recorded, a raw snapshot is taken every
+// CacheInterval frames and kept compressed, each on its own so any of them can
+// be dropped. When the budget runs out the least recently used one goes; the
+// one at frame 0 stays, so a seek never has to start from power on.
+// FCEUMOV_SeekTo() loads the nearest snapshot and emulates the remaining frames
+// without drawing them.
+//
+// Near the playhead there is also a window of uncompressed snapshots, one for
+// each of the last CacheInterval frames emulated, slot frame % CacheInterval.
+// Scrubbing back a few frames at a time, as the rewind key does, then replays
+// a frame or two instead of up to CacheInterval. Each snapshot is a plain copy
+// of the state (FCEUSS_SaveRaw), so keeping them costs about as much as one
+// memcpy of the machine per frame; they are not counted in the budget.
+
+#include "types.h"
+#include "fceu.h"
+#include "driver.h"
+#include "state.h"
+#include "movie.h"
+#include "moviecache.h"
+#include "utils/codec.h"
+
+#include <algorithm>
+#include <list>
+#include <map>
+#include <vector>
+
+struct CACHEDSTATE
+{
+	uint32 size;					//uncompressed
+	std::vector<uint8> data;		//compressed
+	std::list<int>::iterator lru;	//position in lru; not set for frame 0
+};
+
+static int CacheInterval = 0;		//frames between snapshots, 0 when the cache is off
+static uint32 CacheBudget = 0;		//bytes
+
+static std::map<int, CACHEDSTATE> states;	//by frame
+static std::list<int> lru;					//frames, most recently used first
+static uint32 cacheBytes = 0;
+
+struct RECENTSTATE
+{
+	int frame;					//-1 when empty
+	std::vector<uint8> data;	//uncompressed
+};
+static std::vector<RECENTSTATE> recent;		//CacheInterval slots
+
+static std::vector<uint8> scratch;
+static std::vector<uint8> packed;
+
+void FCEUMOV_CacheReset(void)
+{
+	states.clear();
+	lru.clear();
+	cacheBytes = 0;
+	for (size_t i = 0; i < recent.size(); i++)
+		recent[i].frame = -1;
+}
+
+void FCEUI_SetMovieCache(int interval, uint32 budget)
+{
+	CacheInterval = interval > 0 ? interval : 0;
+	CacheBudget = budget;
+	std::vector<RECENTSTATE>().swap(recent);
+	recent.resize(CacheInterval);
+	FCEUMOV_CacheReset();
+	if (!CacheInterval)
+	{
+		std::vector<uint8>().swap(scratch);
+		std::vector<uint8>().swap(packed);
+	}
+}
+
+//Newest frame at or before <frame> in the window, or -1
+static int FindRecent(int frame)
+{
+	for (int f = frame; f >= 0 && f > frame - CacheInterval; f--)
+		if (recent[f % CacheInterval].frame == f)
+			return f;
+	return -1;
+}
+
+static void Drop(std::map<int, CACHEDSTATE>::iterator it)
+{
+	cacheBytes -= it->second.data.size();
+	if (it->first != 0)
+		lru.erase(it->second.lru);
+	states.erase(it);
+}
+
+static void Touch(CACHEDSTATE &cs, int frame)
+{
+	if (frame != 0)
+		lru.splice(lru.begin(), lru, cs.lru);
+}
+
+void FCEUMOV_CacheUpdate(void)
+{
+	if (!CacheInterval || !GameInfo || !FCEUMOV_Mode(MOVIEMODE_PLAY|MOVIEMODE_RECORD|MOVIEMODE_FINISHED))
+	{
+		if (!states.empty())
+			FCEUMOV_CacheReset();
+		return;
+	}
+
+	int frame = currFrameCounter;
+
+	//while recording, everything after this frame is about to be replaced
+	if (FCEUMOV_Mode(MOVIEMODE_RECORD))
+	{
+		std::map<int, CACHEDSTATE>::iterator it = states.upper_bound(frame);
+		while (it != states.end())
+			Drop(it++);
+		for (size_t i = 0; i < recent.size(); i++)
+			if (recent[i].frame > frame)
+				recent[i].frame = -1;
+	}
+
+	uint32 len = FCEUSS_RawSize();
+	RECENTSTATE &rs = recent[frame % CacheInterval];
+	if (rs.data.size() != len) rs.data.resize(len);
+	FCEUSS_SaveRaw(&rs.data[0]);
+	rs.frame = frame;
+
+	if (frame % CacheInterval)
+		return;
+
+	std::map<int, CACHEDSTATE>::iterator it = states.find(frame);
+	if (it != states.end())
+	{
+		Touch(it->second, frame);
+		return;
+	}
+
+	uint32 comprlen = FCEU_CodecBound(CODEC_LZ, len);
+	if (packed.size() < comprlen) packed.resize(comprlen);
+	comprlen = FCEU_Compress(CODEC_LZ, 0, &packed[0], comprlen, &rs.data[0], len);
+	if (!comprlen)
+		return;
+
+	CACHEDSTATE &cs = states[frame];
+	cs.size = len;
+	cs.data.assign(packed.begin(), packed.begin() + comprlen);
+	if (frame != 0)
+	{
+		lru.push_front(frame);
+		cs.lru = lru.begin();
+	}
+	cacheBytes += comprlen;
+
+	while (cacheBytes > CacheBudget && !lru.empty())
+		Drop(states.find(lru.back()));
+}
+
+int FCEUMOV_CacheFind(int frame)
+{
+	if (!CacheInterval)
+		return -1;
+	int closest = FindRecent(frame);
+	std::map<int, CACHEDSTATE>::iterator it = states.upper_bound(frame);
+	if (it == states.begin())
+		return closest;
+	return std::max(closest, (--it)->first);
+}
+
+int FCEUMOV_CacheRestore(int frame)
+{
+	if (!CacheInterval)
+		return -1;
+	int closest = FindRecent(frame);
+	std::map<int, CACHEDSTATE>::iterator it = states.upper_bound(frame);
+	int sparse = it == states.begin() ? -1 : (--it)->first;
+	if (closest >= 0 && closest >= sparse)
+	{
+		RECENTSTATE &rs = recent[closest % CacheInterval];
+		if (rs.data.size() == FCEUSS_RawSize())
+		{
+			FCEUSS_LoadRaw(&rs.data[0]);
+			return closest;
+		}
+		rs.frame = -1;
+	}
+	if (sparse < 0)
+		return -1;
+
+	CACHEDSTATE &cs = it->second;
+	if (cs.size != FCEUSS_RawSize())
+	{
+		FCEUMOV_CacheReset();
+		return -1;
+	}
+	if (scratch.size() < cs.size) scratch.resize(cs.size);
+	if (!FCEU_Decompress(CODEC_LZ, &scratch[0], cs.size, &cs.data[0], cs.data.size()))
+	{
+		Drop(it);
+		return -1;
+	}
+	FCEUSS_LoadRaw(&scratch[0]);
+	Touch(cs, it->first);
+	return it->first;
+}
@@ -0,0 +1,19 @@
+#ifndef _MOVIECACHE_H_
+#define _MOVIECACHE_H_
+
+//Drops every cached state. Called when a movie is loaded, started, stopped or
+//replaced by the one in a savestate.
+void FCEUMOV_CacheReset(void);
+
+//Called once per emulated frame before input is read; caches a state every
+//CacheInterval frames while a movie is played or recorded.
+void FCEUMOV_CacheUpdate(void);
+
+//Loads the newest cached state taken at or before <frame>. Returns the frame
+//it was taken at, or -1 if there is none.
+int FCEUMOV_CacheRestore(int frame);
+
+//Frame of the newest cached state at or before <frame>, or -1
+int FCEUMOV_CacheFind(int frame);
+
+#endif
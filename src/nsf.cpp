@@ -135,8 +135,8 @@ void NSFGI(GI h)
 	switch(h)
 	{
 	case GI_CLOSE:
-		if(NSFDATA) {free(NSFDATA);NSFDATA=0;}
-		if(ExWRAM) {free(ExWRAM);ExWRAM=0;}
+		if(NSFDATA) {FCEU_gfree(NSFDATA);NSFDATA=0;}
+		if(ExWRAM) {FCEU_gfree(ExWRAM);ExWRAM=0;}
 		if(NSFHeader.SoundChip&1) {
 			//   NSFVRC6_Init();
 		} else if(NSFHeader.SoundChip&2) {
@@ -196,7 +196,7 @@ int NSFLoad(const char *name, FCEUFILE *fp)
 	NSFMaxBank=((NSFSize+(LoadAddr&0xfff)+4095)/4096);
 	NSFMaxBank=PRGsize[0]=uppow2(NSFMaxBank);
 
-	if(!(NSFDATA=(uint8 *)FCEU_malloc(NSFMaxBank*4096)))
+	if(!(NSFDATA=(uint8 *)FCEU_gtrymalloc(NSFMaxBank*4096)))
 		return 0;
 
 	FCEU_fseek(fp,0x80,SEEK_SET);
@@ -262,7 +262,7 @@ int NSFLoad(const char *name, FCEUFILE *fp)
 	FCEU_printf(" Name:       %s\n Artist:     %s\n Copyright:  %s\n\n",NSFHeader.SongName,NSFHeader.Artist,NSFHeader.Copyright);
 	if(NSFHeader.SoundChip)
 	{
-		static char *tab[6]={"Konami VRCVI","Konami VRCVII","Nintendo FDS","Nintendo MMC5","Namco 106","Sunsoft FME-07"};
+		static const char *tab[6]={"Konami VRCVI","Konami VRCVII","Nintendo FDS","Nintendo MMC5","Namco 106","Sunsoft FME-07"};
 
 		for(x=0;x<6;x++)
 			if(NSFHeader.SoundChip&(1<<x))
@@ -654,11 +654,13 @@ EFCM_CONVERTRESULT convert_fcm(MovieData& md, std::string fname)
 		if(i==0 && initreset)
 			joopcmd = MOVIECMD_RESET;
 		_addjoy();
-		md.records[i].commands = joopcmd;
+		MovieRecord mr;
+		mr.commands = joopcmd;
 		for(int j=0;j<4;j++) {
 			joymask[j] |= joop[j];
-			md.records[i].joysticks[j] = joop[j];
+			mr.joysticks[j] = joop[j];
 		}
+		md.records.set(i, mr);
 	}
 
 	md.ports[2] = SIS_NONE;
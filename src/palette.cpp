@@ -29,6 +29,7 @@
 #endif
 
 #include "palette.h"
+#include "video.h"
 #include "palettes/palettes.h"
 
 #ifndef M_PI
@@ -619,6 +620,7 @@ void FCEU_DrawNTSCControlBars(uint8 *XBuf)
 	if(!controllength) return;
 	controllength--;
 	if(!XBuf) return;
+	FCEU_BeginOverlay();
 
 	if(controlselect==1)
 	{
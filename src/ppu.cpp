@@ -1019,7 +1019,7 @@ static void RefreshLine(int lastpixel) {
 	uint32 vofs;
 	int X1;
 
-	register uint8 *P = Pline;
+	uint8 *P = Pline;
 	int lasttile = lastpixel >> 3;
 	int numtiles;
 	static int norecurse = 0;	// Yeah, recursion would be bad.
@@ -1279,6 +1279,10 @@ static void DoLine(void) {
 	for (x = 63; x >= 0; x--)
 		*(uint32*)&dtarget[x << 2] = ((PPU[1]>>5)<<0)|((PPU[1]>>5)<<8)|((PPU[1]>>5)<<16)|((PPU[1]>>5)<<24);
 
+	//the line is final now, hand it to the driver while it is still in cache
+	if (FCEU_LineHook && scanline < 240)
+		FCEU_LineHook(scanline, target);
+
 	sphitx = 0x100;
 
 	if (ScreenON || SpriteON)
@@ -0,0 +1,272 @@
+/* FCE Ultra - NES/Famicom Emulator
+ *
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation; either version 2 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 675 Mass Ave, Cambridge, MA 02139, USA.
+ */
+
+// In-memory rewind.
+// A snapshot is taken every RewindInterval frames. Only the newest one is kept
+// whole; each older one is stored as its XOR against the snapshot that followed
+// it, compressed. Mostly identical states XOR to mostly zeros, which pack down
+// to a few KB. Stepping back undoes one delta at a time, and the oldest delta
+// can be dropped when the budget runs out without touching the others.
+// Inputs are logged per frame so the frames between a snapshot and the rewind
+// target can be re-emulated exactly.
+
+#include "types.h"
+#include "fceu.h"
+#include "driver.h"
+#include "state.h"
+#include "movie.h"
+#include "input.h"
+#include "sound.h"
+#include "video.h"
+#include "netplay.h"
+#include "rewind.h"
+#include "utils/codec.h"
+
+#include <algorithm>
+#include <deque>
+#include <vector>
+
+struct REWINDDELTA
+{
+	int frame;					//frame the older snapshot was taken at
+	uint32 size;				//its uncompressed size
+	std::vector<uint8> data;	//older ^ newer, zero padded to the longer of the two, compressed
+};
+
+static int RewindInterval = 0;		//frames between snapshots, 0 when rewind is off
+static uint32 RewindBudget = 0;		//bytes
+
+static std::deque<REWINDDELTA> deltas;	//oldest first
+static uint32 deltaBytes = 0;
+static std::vector<uint8> lastState;	//newest snapshot, uncompressed
+static int lastFrame = -1;				//frame lastState was taken at, -1 if there is none
+static std::deque<MovieRecord> inputLog;	//input of every frame since the oldest snapshot
+static int inputBase = 0;				//frame of inputLog[0]
+static int frameCount = 0;				//frames emulated since the last reset
+static int replayEnd = 0;				//frames before this one take their input from inputLog
+static bool rewindRequested = false;
+
+static std::vector<uint8> scratch;		//capture and decompression buffer
+static std::vector<uint8> packed;		//compression buffer
+
+static uint32 RewindUsage(void)
+{
+	return deltaBytes + lastState.size() + inputLog.size() * sizeof(MovieRecord);
+}
+
+static void XorInto(std::vector<uint8> &dst, const uint8 *src, uint32 len)
+{
+	if (dst.size() < len)
+		dst.resize(len, 0);
+	uint8 *d = &dst[0];
+	for (uint32 i = 0; i < len; i++)
+		d[i] ^= src[i];
+}
+
+void FCEU_RewindReset(void)
+{
+	deltas.clear();
+	deltaBytes = 0;
+	lastState.clear();
+	lastFrame = -1;
+	inputLog.clear();
+	inputBase = 0;
+	frameCount = 0;
+	replayEnd = 0;
+	rewindRequested = false;
+}
+
+void FCEUI_SetRewind(int interval, uint32 budget)
+{
+	RewindInterval = interval > 0 ? interval : 0;
+	RewindBudget = budget;
+	FCEU_RewindReset();
+	if (!RewindInterval)
+	{
+		std::vector<uint8>().swap(lastState);
+		std::vector<uint8>().swap(scratch);
+		std::vector<uint8>().swap(packed);
+	}
+}
+
+void FCEUI_Rewind(void)
+{
+	if (RewindInterval)
+		rewindRequested = true;
+}
+
+static void TrimInputLog(void)
+{
+	int oldest = deltas.empty() ? lastFrame : deltas.front().frame;
+	while (inputBase < oldest && !inputLog.empty())
+	{
+		inputLog.pop_front();
+		inputBase++;
+	}
+}
+
+static void Capture(void)
+{
+	uint32 len = FCEUSS_RawSize();
+	if (scratch.size() < len) scratch.resize(len);
+	FCEUSS_SaveRaw(&scratch[0]);
+
+	if (lastFrame >= 0)
+	{
+		uint32 size = lastState.size();
+		XorInto(lastState, &scratch[0], len);
+
+		uint32 comprlen = FCEU_CodecBound(CODEC_LZ, lastState.size());
+		if (packed.size() < comprlen) packed.resize(comprlen);
+		comprlen = FCEU_Compress(CODEC_LZ, 0, &packed[0], comprlen, &lastState[0], lastState.size());
+		if (comprlen)
+		{
+			deltas.push_back(REWINDDELTA());
+			REWINDDELTA &d = deltas.back();
+			d.frame = lastFrame;
+			d.size = size;
+			d.data.assign(packed.begin(), packed.begin() + comprlen);
+			deltaBytes += comprlen;
+		} else
+		{
+			//the chain is broken, start a new one from this snapshot
+			deltas.clear();
+			deltaBytes = 0;
+			inputLog.clear();
+			inputBase = frameCount;
+		}
+	}
+
+	lastState.assign(scratch.begin(), scratch.begin() + len);
+	lastFrame = frameCount;
+
+	while (!deltas.empty() && RewindUsage() > RewindBudget)
+	{
+		deltaBytes -= deltas.front().data.size();
+		deltas.pop_front();
+	}
+	TrimInputLog();
+}
+
+void FCEU_RewindUpdate(void)
+{
+	if (!RewindInterval || !GameInfo || GameInfo->type == GIT_NSF)
+		return;
+
+	//movies and netplay own the input timeline
+	if (!FCEUMOV_Mode(MOVIEMODE_INACTIVE) || FCEUnetplay)
+	{
+		if (lastFrame >= 0)
+			FCEU_RewindReset();
+		return;
+	}
+
+	if (lastFrame < 0 || frameCount - lastFrame >= RewindInterval)
+		Capture();
+}
+
+bool FCEU_RewindReplaying(void)
+{
+	return lastFrame >= 0 && frameCount < replayEnd;
+}
+
+void FCEU_RewindInput(void)
+{
+	if (lastFrame < 0)
+		return;
+
+	uint32 index = frameCount - inputBase;
+	if (frameCount < replayEnd && index < inputLog.size())
+	{
+		joyports[0].load(&inputLog[index]);
+		joyports[1].load(&inputLog[index]);
+	} else
+	{
+		//new input overwrites whatever was rewound over
+		if (index < inputLog.size())
+			inputLog.resize(index);
+		inputLog.push_back(MovieRecord());
+		joyports[0].log(&inputLog.back());
+		joyports[1].log(&inputLog.back());
+	}
+	frameCount++;
+}
+
+bool FCEU_RewindEmulate(uint8 **pXBuf, int32 **SoundBuf, int32 *SoundBufSize, int skip)
+{
+	if (!rewindRequested)
+		return false;
+	rewindRequested = false;
+	if (lastFrame < 0)
+		return false;
+
+	//the frame to show is target - 1, so a snapshot at or before it is needed
+	int target = frameCount - 1;
+	while (lastFrame > target - 1)
+	{
+		if (deltas.empty())
+		{
+			//nothing older left; hold the current picture
+			FCEU_RestoreBackBuf();
+			FCEU_PutImage();
+			*pXBuf = XBuf;
+			*SoundBuf = WaveFinal;
+			*SoundBufSize = 0;
+			return true;
+		}
+
+		REWINDDELTA &d = deltas.back();
+		uint32 len = std::max<uint32>(d.size, lastState.size());
+		if (scratch.size() < len) scratch.resize(len);
+		if (!FCEU_Decompress(CODEC_LZ, &scratch[0], len, &d.data[0], d.data.size()))
+		{
+			FCEUD_PrintError("Rewind buffer is corrupted, clearing it.");
+			FCEU_RewindReset();
+			return false;
+		}
+		XorInto(lastState, &scratch[0], len);
+		lastState.resize(d.size);
+		lastFrame = d.frame;
+		deltaBytes -= d.data.size();
+		deltas.pop_back();
+	}
+
+	if (lastState.size() != FCEUSS_RawSize())
+	{
+		FCEU_RewindReset();
+		return false;
+	}
+	FCEUSS_LoadRaw(&lastState[0]);
+	frameCount = lastFrame;
+	replayEnd = target;
+
+	//re-emulate up to the target without drawing or mixing sound, then run the
+	//last frame normally so the driver gets a picture
+	int paused = EmulationPaused;
+	EmulationPaused = 0;
+	uint8 *gfx;
+	int32 *sound;
+	int32 ssize;
+	while (frameCount < target - 1)
+		FCEUI_Emulate(&gfx, &sound, &ssize, 2);
+	FCEUI_Emulate(pXBuf, SoundBuf, SoundBufSize, skip);
+	EmulationPaused = paused;
+
+	//a single frame of audio played while stepping back is just a click
+	*SoundBufSize = 0;
+	return true;
+}
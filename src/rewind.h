@@ -0,0 +1,23 @@
+#ifndef _REWIND_H_
+#define _REWIND_H_
+
+//Drops every snapshot and the input log. Called whenever the timeline is cut:
+//game load/close, power, reset and loading a savestate.
+void FCEU_RewindReset(void);
+
+//Called once per emulated frame before input is read; takes a snapshot every
+//RewindInterval frames.
+void FCEU_RewindUpdate(void);
+
+//True while frames between a snapshot and the rewind target are re-emulated;
+//the input drivers must not be polled then.
+bool FCEU_RewindReplaying(void);
+
+//Logs (or, while replaying, restores) the input of the frame about to run.
+void FCEU_RewindInput(void);
+
+//Performs a pending FCEUI_Rewind() request. Returns true if the frame was
+//produced here, in which case FCEUI_Emulate must not emulate another one.
+bool FCEU_RewindEmulate(uint8 **pXBuf, int32 **SoundBuf, int32 *SoundBufSize, int skip);
+
+#endif
@@ -0,0 +1,123 @@
+/* FCE Ultra - NES/Famicom Emulator
+ *
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation; either version 2 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 675 Mass Ave, Cambridge, MA 02139, USA.
+ */
+
+// Run-ahead.
+// Most games read the pad during one frame and only show the result one or
+// more frames later. Run-ahead hides that delay: each host frame emulates the
+// real frame with its sound, takes a raw snapshot, emulates RunAheadFrames
+// more frames with the same input and without sound, presents the picture of
+// the last one and goes back to the snapshot.
+//
+// The real frame always takes the exact PPU path, even with FRAMESKIP where a
+// skipped frame would take the approximate one, so the timeline kept is the
+// one that would have run without run-ahead. Only the thrown away frames are
+// skipped. Overlay timers and the lag counter only count real frames.
+//
+// The core keeps all of its state in globals, so there can't be a second
+// emulator instance to run ahead on. In the second instance mode the sound
+// mixer state that savestates leave out is kept and restored as well, so the
+// thrown away frames leave the audio exactly as if they had run elsewhere.
+// Without it, the skipped frames still render their channels into the mix
+// buffers, which can click.
+
+#include "types.h"
+#include "fceu.h"
+#include "driver.h"
+#include "state.h"
+#include "movie.h"
+#include "sound.h"
+#include "netplay.h"
+#include "rewind.h"
+#include "runahead.h"
+#ifdef _S9XLUA_H
+#include "fceulua.h"
+#endif
+
+#include <string.h>
+#include <vector>
+
+static int RunAheadFrames = 0;		//frames shown ahead of the real one, 0 when off
+static bool RunAheadSecondInstance = false;
+
+static bool inside = false;			//FCEU_RunAheadEmulate is on the stack
+static bool speculating = false;
+static std::vector<uint8> snapshot;
+static int32 realSound[sizeof(WaveFinal) / sizeof(WaveFinal[0])];
+
+void FCEUI_SetRunAhead(int frames, bool secondInstance)
+{
+	RunAheadFrames = frames > 0 ? frames : 0;
+	RunAheadSecondInstance = secondInstance;
+	if (!RunAheadFrames)
+		std::vector<uint8>().swap(snapshot);
+}
+
+bool FCEU_RunAheadSpeculating(void)
+{
+	return speculating;
+}
+
+bool FCEU_RunAheadEmulate(uint8 **pXBuf, int32 **SoundBuf, int32 *SoundBufSize, int skip)
+{
+	//frames the driver skips anyway need no picture from the future
+	if (!RunAheadFrames || inside || skip || EmulationPaused || !GameInfo || GameInfo->type == GIT_NSF)
+		return false;
+
+	//movies, netplay, scripts and rewind replays must see every frame exactly once
+	if (!FCEUMOV_Mode(MOVIEMODE_INACTIVE) || FCEUnetplay || FCEU_RewindReplaying())
+		return false;
+#ifdef _S9XLUA_H
+	if (FCEU_LuaRunning())
+		return false;
+#endif
+
+	inside = true;
+
+	//the real frame; its sound is what gets played
+	FCEUI_Emulate(pXBuf, SoundBuf, SoundBufSize, 0);
+	int32 ssize = *SoundBufSize;
+	if (ssize)
+		memcpy(realSound, *SoundBuf, ssize * sizeof(int32));
+
+	uint32 len = FCEUSS_RawSize();
+	if (snapshot.size() < len) snapshot.resize(len);
+	FCEUSS_SaveRaw(&snapshot[0]);
+	if (RunAheadSecondInstance)
+		FCEUSND_SaveMixer();
+
+	//a pause requested by the real frame takes effect on the next one
+	int paused = EmulationPaused;
+	EmulationPaused = 0;
+	speculating = true;
+	uint8 *gfx;
+	int32 *sound;
+	int32 soundsize;
+	for (int i = 1; i < RunAheadFrames; i++)
+		FCEUI_Emulate(&gfx, &sound, &soundsize, 2);
+	FCEUI_Emulate(pXBuf, &sound, &soundsize, 3);
+	speculating = false;
+	EmulationPaused = paused;
+
+	FCEUSS_LoadRaw(&snapshot[0]);
+	if (RunAheadSecondInstance)
+		FCEUSND_LoadMixer();
+
+	*SoundBuf = realSound;
+	*SoundBufSize = ssize;
+	inside = false;
+	return true;
+}
@@ -0,0 +1,13 @@
+#ifndef _RUNAHEAD_H_
+#define _RUNAHEAD_H_
+
+//True while the frames run ahead of the real one are emulated. Nothing that
+//outlives the frame (rewind, autosaves, autofire) may be updated then.
+bool FCEU_RunAheadSpeculating(void);
+
+//Emulates one host frame with run-ahead when it is on and allowed. Returns
+//true if the frame was produced here, in which case FCEUI_Emulate must not
+//emulate another one.
+bool FCEU_RunAheadEmulate(uint8 **pXBuf, int32 **SoundBuf, int32 *SoundBufSize, int skip);
+
+#endif
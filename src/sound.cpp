@@ -814,12 +814,13 @@ static void RDoTriangle(void)
  ChannelBC[2]=SOUNDTS;
 }
 
+//low quality triangle/noise/PCM renderer phase
+static uint32 tcout=0;
+static int32 triacc=0;
+static int32 noiseacc=0;
+
 static void RDoTriangleNoisePCMLQ(void)
 {
-   static uint32 tcout=0;
-   static int32 triacc=0;
-   static int32 noiseacc=0;
-
    int32 V;
    int32 start,end;
    int32 freq[2];
@@ -1128,6 +1129,61 @@ int GetSoundBuffer(int32 **W)
  return(inbuf);
 }
 
+//Mixer state that savestates leave out: waveform phases, where each channel
+//has rendered up to, and the samples still waiting in Wave/WaveHi.
+static struct
+{
+ int32 tristep, wlcount[4], RectDutyCount[2], sqacc[2];
+ uint32 ChannelBC[5], soundtsoffs;
+ uint32 tcout;
+ int32 triacc, noiseacc;
+ int32 inbuf;
+} mixerSave;
+static int32 WaveSave[sizeof(WaveHi)/sizeof(WaveHi[0])];
+
+void FCEUSND_SaveMixer(void)
+{
+ mixerSave.tristep=tristep;
+ memcpy(mixerSave.wlcount,wlcount,sizeof(wlcount));
+ memcpy(mixerSave.RectDutyCount,RectDutyCount,sizeof(RectDutyCount));
+ memcpy(mixerSave.sqacc,sqacc,sizeof(sqacc));
+ memcpy(mixerSave.ChannelBC,ChannelBC,sizeof(ChannelBC));
+ mixerSave.soundtsoffs=soundtsoffs;
+ mixerSave.tcout=tcout;
+ mixerSave.triacc=triacc;
+ mixerSave.noiseacc=noiseacc;
+ mixerSave.inbuf=inbuf;
+
+ //after a flush only the leftover at the start of the buffer is in use
+ if(FSettings.soundq>=1)
+  memcpy(WaveSave,WaveHi,soundtsoffs*sizeof(int32));
+ else
+  memcpy(WaveSave,Wave,sizeof(Wave));
+}
+
+void FCEUSND_LoadMixer(void)
+{
+ tristep=mixerSave.tristep;
+ memcpy(wlcount,mixerSave.wlcount,sizeof(wlcount));
+ memcpy(RectDutyCount,mixerSave.RectDutyCount,sizeof(RectDutyCount));
+ memcpy(sqacc,mixerSave.sqacc,sizeof(sqacc));
+ memcpy(ChannelBC,mixerSave.ChannelBC,sizeof(ChannelBC));
+ soundtsoffs=mixerSave.soundtsoffs;
+ tcout=mixerSave.tcout;
+ triacc=mixerSave.triacc;
+ noiseacc=mixerSave.noiseacc;
+ inbuf=mixerSave.inbuf;
+
+ if(FSettings.soundq>=1)
+ {
+  memcpy(WaveHi,WaveSave,soundtsoffs*sizeof(int32));
+  memset(WaveHi+soundtsoffs,0,sizeof(WaveHi)-soundtsoffs*sizeof(int32));
+  if(GameExpSound.HiSync) GameExpSound.HiSync(soundtsoffs);
+ }
+ else
+  memcpy(Wave,WaveSave,sizeof(Wave));
+}
+
 /* FIXME:  Find out what sound registers get reset on reset.  I know $4001/$4005 don't,
 due to that whole MegaMan 2 Game Genie thing.
 */
@@ -69,6 +69,11 @@ void FCEUSND_Reset(void);
 void FCEUSND_SaveState(void);
 void FCEUSND_LoadState(int version);
 
+//Keep and restore one copy of the mixer state that savestates don't cover, so
+//frames emulated between the two calls leave no trace in the sound output.
+void FCEUSND_SaveMixer(void);
+void FCEUSND_LoadMixer(void);
+
 void FCEU_SoundCPUHook(int);
 void Write_IRQFM (uint32 A, uint8 V); //mbg merge 7/17/06 brought over from latest mmbuild
 
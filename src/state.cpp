@@ -26,6 +26,7 @@
 #include "fceu.h"
 #include "sound.h"
 #include "utils/endian.h"
+#include "utils/crc32.h"
 #include "utils/memory.h"
 #include "utils/xstring.h"
 #include "file.h"
@@ -38,6 +39,10 @@
 #include "input.h"
 #include "zlib.h"
 #include "driver.h"
+#include "rewind.h"
+#include "runahead.h"
+#include "utils/asyncio.h"
+#include "utils/codec.h"
 #ifdef _S9XLUA_H
 #include "fceulua.h"
 #endif
@@ -57,6 +62,7 @@
 
 #include <vector>
 #include <fstream>
+#include <atomic>
 
 using namespace std;
 
@@ -81,11 +87,30 @@ bool internalSaveLoad = false;
 
 bool backupSavestates = true;
 bool compressSavestates = true;  //By default FCEUX compresses savestates when a movie is inactive.
+int backBufferSavestates = SSBACKBUF_RAW;
+int savestateCodec = CODEC_ZLIB;
+bool thumbnailSavestates = true;
 
 // a temp memory stream. We'll be dumping some data here and then compress
 EMUFILE_MEMORY memory_savestate;
+// the state being loaded, decompressed and checked here before it is applied
+static EMUFILE_MEMORY staging_savestate;
 // temporary buffer for compressed data of a savestate
 std::vector<uint8> compressed_buf;
+// the thumbnail block of the savestate being written
+static std::vector<uint8> thumbnail_buf;
+// the state from just before the last load: what LoadBackup returns to, and
+// what a load that fails halfway through is rolled back to. Without a movie it
+// is a raw snapshot (FCEUSS_SaveRaw), which costs next to nothing; with one it
+// has to be a full state, since that carries the movie
+static EMUFILE_MEMORY backupState;
+static bool backupStateRaw = false;
+static std::vector<uint8> backupFrame;	//the back buffer, which a raw snapshot leaves out
+static bool backupStateCurrent = false;	//backupState still matches the emulation
+static void MakeBackupState(bool full);
+static void RestoreBackupState();
+// temporary buffer for the compressed back buffer chunk
+static std::vector<uint8> compressed_backbuf;
 
 #define SFMDATA_SIZE (64)
 static SFORMAT SFMDATA[SFMDATA_SIZE];
@@ -186,14 +211,14 @@ static int WriteStateChunk(EMUFILE* os, int type, SFORMAT *sf)
 	return (bsize+5);
 }
 
-static SFORMAT *CheckS(SFORMAT *sf, uint32 tsize, char *desc)
+static SFORMAT *ScanS(SFORMAT *sf, uint32 tsize, char *desc)
 {
 	while(sf->v)
 	{
 		if(sf->s==~0)		// Link to another SFORMAT structure.
 		{
 			SFORMAT *tmp;
-			if((tmp= CheckS((SFORMAT *)sf->v, tsize, desc) ))
+			if((tmp= ScanS((SFORMAT *)sf->v, tsize, desc) ))
 				return(tmp);
 			sf++;
 			continue;
@@ -209,6 +234,128 @@ static SFORMAT *CheckS(SFORMAT *sf, uint32 tsize, char *desc)
 	return(0);
 }
 
+//Tag lookup for state loading. Each top level SFORMAT table, including the
+//tables it links to, gets an open addressed hash of its 4 byte descriptors the
+//first time it is read, so a chunk loads in linear time. SFMDATA's index is
+//dropped whenever AddExState/ResetExState change it.
+struct SFSLOT
+{
+	uint32 tag;
+	SFORMAT *sf;	//NULL for an empty slot
+};
+
+struct SFINDEX
+{
+	SFORMAT *table;
+	std::vector<SFSLOT> slots;	//power of two sized; empty until built
+};
+
+#define SFINDEX_MAX (16)
+static SFINDEX sfIndex[SFINDEX_MAX];
+static int sfIndexCount = 0;
+
+static inline uint32 TagOf(const char *desc)
+{
+	uint32 tag;
+	memcpy(&tag,desc,4);
+	return tag;
+}
+
+static inline uint32 HashTag(uint32 tag)
+{
+	tag *= 0x9E3779B1;
+	return tag ^ (tag >> 16);
+}
+
+static int CountFields(SFORMAT *sf)
+{
+	int n = 0;
+	for(; sf->v; sf++)
+		n += (sf->s==~0) ? CountFields((SFORMAT *)sf->v) : 1;
+	return n;
+}
+
+static void IndexFields(std::vector<SFSLOT> &slots, SFORMAT *sf)
+{
+	uint32 mask = slots.size() - 1;
+	for(; sf->v; sf++)
+	{
+		if(sf->s==~0)
+		{
+			IndexFields(slots,(SFORMAT *)sf->v);
+			continue;
+		}
+		if(!sf->desc)
+			continue;
+
+		//the first field with a tag wins, as it did with the linear search
+		uint32 tag = TagOf(sf->desc);
+		uint32 h = HashTag(tag) & mask;
+		while(slots[h].sf && slots[h].tag != tag)
+			h = (h+1) & mask;
+		if(!slots[h].sf)
+		{
+			slots[h].tag = tag;
+			slots[h].sf = sf;
+		}
+	}
+}
+
+static SFINDEX *GetIndex(SFORMAT *sf)
+{
+	SFINDEX *idx = 0;
+	for(int i=0;i<sfIndexCount;i++)
+		if(sfIndex[i].table == sf)
+			idx = &sfIndex[i];
+	if(!idx)
+	{
+		if(sfIndexCount == SFINDEX_MAX)
+			return 0;
+		idx = &sfIndex[sfIndexCount++];
+		idx->table = sf;
+	}
+
+	if(idx->slots.empty())
+	{
+		//keep the load factor at or below one half
+		uint32 size = 16;
+		while(size < 2 * (uint32)CountFields(sf))
+			size <<= 1;
+		SFSLOT empty = { 0, 0 };
+		idx->slots.assign(size, empty);
+		IndexFields(idx->slots, sf);
+	}
+	return idx;
+}
+
+static void InvalidateIndex(SFORMAT *sf)
+{
+	for(int i=0;i<sfIndexCount;i++)
+		if(sfIndex[i].table == sf)
+			sfIndex[i].slots.clear();
+}
+
+static SFORMAT *CheckS(SFORMAT *sf, uint32 tsize, char *desc)
+{
+	SFINDEX *idx = GetIndex(sf);
+	if(!idx)
+		return ScanS(sf,tsize,desc);
+
+	uint32 mask = idx->slots.size() - 1;
+	uint32 tag = TagOf(desc);
+	for(uint32 h = HashTag(tag) & mask; idx->slots[h].sf; h = (h+1) & mask)
+	{
+		if(idx->slots[h].tag == tag)
+		{
+			SFORMAT *tmp = idx->slots[h].sf;
+			if(tsize!=(tmp->s&(~FCEUSTATE_FLAGS)))
+				return(0);
+			return(tmp);
+		}
+	}
+	return(0);
+}
+
 static bool ReadStateChunk(EMUFILE* is, SFORMAT *sf, int size)
 {
 	SFORMAT *tmp;
@@ -241,6 +388,126 @@ static bool ReadStateChunk(EMUFILE* is, SFORMAT *sf, int size)
 	return true;
 }
 
+//Raw snapshots: the registered SFORMAT tables flattened into a list of memory
+//spans, copied back to back with no descriptors, byte order flips or compression.
+struct RAWSPAN
+{
+	void *v;		//the data, or a pointer to it for FCEUSTATE_INDIRECT fields
+	uint32 size;
+	bool indirect;
+};
+
+static std::vector<RAWSPAN> rawSpans;
+static uint32 rawSize = 0;
+static uint32 rawLayout = 0;		//CRC32 of every field's name and size
+static bool rawSpansValid = false;	//cleared whenever AddExState/ResetExState change SFMDATA
+
+static void AddRawSpans(SFORMAT *sf)
+{
+	for(; sf->v; sf++)
+	{
+		if(sf->s==~0)		//Link to another struct
+		{
+			AddRawSpans((SFORMAT *)sf->v);
+			continue;
+		}
+
+		uint32 size = sf->s&(~FCEUSTATE_FLAGS);
+		bool indirect = (sf->s&FCEUSTATE_INDIRECT) != 0;
+		if(!size)
+			continue;
+		rawSize += size;
+
+		uint8 desc[8] = { 0 };
+		strncpy((char*)desc, sf->desc, 4);
+		FCEU_en32lsb(desc + 4, size);
+		rawLayout = CalcCRC32(rawLayout, desc, 8);
+
+		//fields laid out next to each other in memory become a single copy
+		if(!indirect && !rawSpans.empty())
+		{
+			RAWSPAN &last = rawSpans.back();
+			if(!last.indirect && (uint8*)last.v + last.size == (uint8*)sf->v)
+			{
+				last.size += size;
+				continue;
+			}
+		}
+
+		RAWSPAN span = { sf->v, size, indirect };
+		rawSpans.push_back(span);
+	}
+}
+
+static void BuildRawSpans(void)
+{
+	rawSpans.clear();
+	rawSize = 0;
+	rawLayout = 0;
+	AddRawSpans(SFCPU);
+	AddRawSpans(SFCPUC);
+	AddRawSpans(FCEUPPU_STATEINFO);
+	AddRawSpans(FCEU_NEWPPU_STATEINFO);
+	AddRawSpans(FCEUCTRL_STATEINFO);
+	AddRawSpans(FCEUSND_STATEINFO);
+	AddRawSpans(SFMDATA);
+	rawSpansValid = true;
+}
+
+uint32 FCEUSS_RawSize(void)
+{
+	if(!rawSpansValid)
+		BuildRawSpans();
+	return rawSize;
+}
+
+uint32 FCEUSS_RawLayout(void)
+{
+	if(!rawSpansValid)
+		BuildRawSpans();
+	return rawLayout;
+}
+
+void FCEUSS_SaveRaw(uint8 *buf)
+{
+	if(!rawSpansValid)
+		BuildRawSpans();
+
+	FCEUPPU_SaveState();
+	FCEUSND_SaveState();
+	if(SPreSave) SPreSave();
+
+	for(size_t i = 0; i < rawSpans.size(); i++)
+	{
+		const RAWSPAN &span = rawSpans[i];
+		memcpy(buf, span.indirect ? *(uint8 **)span.v : (uint8 *)span.v, span.size);
+		buf += span.size;
+	}
+
+	if(SPostSave) SPostSave();
+}
+
+void FCEUSS_LoadRaw(const uint8 *buf)
+{
+	if(!rawSpansValid)
+		BuildRawSpans();
+
+	for(size_t i = 0; i < rawSpans.size(); i++)
+	{
+		const RAWSPAN &span = rawSpans[i];
+		memcpy(span.indirect ? *(uint8 **)span.v : (uint8 *)span.v, buf, span.size);
+		buf += span.size;
+	}
+
+	if(GameStateRestore)
+		GameStateRestore(FCEU_VERSION_NUMERIC);
+	FCEUPPU_LoadState(FCEU_VERSION_NUMERIC);
+	FCEUSND_LoadState(FCEU_VERSION_NUMERIC);
+
+	extern int resetDMCacc;
+	resetDMCacc=0;
+}
+
 static int read_sfcpuc=0, read_snd=0;
 
 void FCEUD_BlitScreen(uint8 *XBuf); //mbg merge 7/17/06 YUCKY had to add
@@ -308,19 +575,32 @@ static bool ReadStateChunks(EMUFILE* is, int32 totalsize)
 				extern uint8 *XBackBuf;
 				if(is->fread((char*)XBackBuf,size) != size)
 					ret = false;
-
-				//MBG TODO - can this be moved to a better place?
-				//does it even make sense, displaying XBuf when its XBackBuf we just loaded?
-#if defined(WIN32) && !defined(DINGUX)
 				else
 				{
+					FCEU_BackBufLoaded();
+
+					//MBG TODO - can this be moved to a better place?
+					//does it even make sense, displaying XBuf when its XBackBuf we just loaded?
+#if defined(WIN32) && !defined(DINGUX)
 					FCEUD_BlitScreen(XBuf);
 					UpdateFCEUWindow();
-				}
 #endif
+				}
 
 			}
 			break;
+		case 9:
+			// load compressed back buffer
+			{
+				extern uint8 *XBackBuf;
+				uLongf len = 256 * 256;
+				if(compressed_backbuf.size() < size) compressed_backbuf.resize(size);
+				//a damaged picture isn't worth refusing the state over; the next frame redraws it
+				if(is->fread((char*)&compressed_backbuf[0],size) == size
+					&& uncompress(XBackBuf, &len, &compressed_backbuf[0], size) == Z_OK)
+					FCEU_BackBufLoaded();
+			}
+			break;
 		case 2:
 			{
 				if(!ReadStateChunk(is,SFCPUC,size))
@@ -363,7 +643,84 @@ int CurrentState=0;
 extern int geniestage;
 
 
-bool FCEUSS_SaveMS(EMUFILE* outstream, int compressionLevel)
+//The comprlen field of the FCSX header: -1 for an uncompressed state, otherwise
+//the codec in the top byte and the compressed size below it. States written
+//before there was a choice of codec have 0 (CODEC_ZLIB) up there.
+#define SS_COMPRLEN(codec,len)	((int)(((uint32)(codec) << 24) | (len)))
+#define SS_COMPRLEN_CODEC(c)	((uint32)(c) >> 24)
+#define SS_COMPRLEN_SIZE(c)		((uint32)(c) & 0x00FFFFFF)
+
+//Set in the version field of the FCSX header when a thumbnail block follows
+//the header: its size (4 bytes), width and height (2 bytes each), then
+//width*height RGB565 pixels, all little endian and never compressed, so a
+//menu can show the picture without touching the rest of the file.
+#define SS_THUMBNAIL			0x40000000
+#define SS_THUMBNAIL_MAXSIZE	(1 << 20)
+
+//Shrinks the back buffer into a thumbnail block: the overscan lines are cut
+//off and every 4x4 block of pixels is averaged into one.
+static void MakeThumbnail(std::vector<uint8> &block)
+{
+	const int w = FCEU_THUMBNAIL_WIDTH, h = FCEU_THUMBNAIL_HEIGHT;
+	const int scale = 256 / w;
+	const int top = (240 - h * scale) / 2;
+
+	uint8 pal[256][3];
+	for(int i = 0; i < 256; i++)
+		FCEUD_GetPalette(i, &pal[i][0], &pal[i][1], &pal[i][2]);
+
+	block.resize(8 + w * h * 2);
+	FCEU_en32lsb(&block[0], 4 + w * h * 2);
+	FCEU_en16lsb(&block[4], w);
+	FCEU_en16lsb(&block[6], h);
+
+	const uint8 *src = FCEU_GetBackBuf();
+	uint8 *out = &block[8];
+	for(int y = 0; y < h; y++)
+	{
+		for(int x = 0; x < w; x++)
+		{
+			uint32 r = 0, g = 0, b = 0;
+			const uint8 *p = src + (top + y * scale) * 256 + x * scale;
+			for(int sy = 0; sy < scale; sy++, p += 256)
+			{
+				for(int sx = 0; sx < scale; sx++)
+				{
+					r += pal[p[sx]][0];
+					g += pal[p[sx]][1];
+					b += pal[p[sx]][2];
+				}
+			}
+			r /= scale * scale;
+			g /= scale * scale;
+			b /= scale * scale;
+			FCEU_en16lsb(out, ((r >> 3) << 11) | ((g >> 2) << 5) | (b >> 3));
+			out += 2;
+		}
+	}
+}
+
+//Size of the FCSX header plus the thumbnail block after it, if there is one
+static uint32 StateBodyOffset(uint8 *image)
+{
+	if(!(FCEU_de32lsb(image + 8) & SS_THUMBNAIL))
+		return 16;
+	return 16 + 4 + FCEU_de32lsb(image + 16);
+}
+
+//Compresses a state body into out. Returns the compressed size, or 0 if the
+//state should be stored uncompressed instead.
+static uint32 PackState(int codec, int level, const uint8 *body, uint32 len, std::vector<uint8> &out)
+{
+	uint32 bound = FCEU_CodecBound(codec, len);
+	if(out.size() < bound) out.resize(bound);
+	uint32 packedlen = FCEU_Compress(codec, level, &out[0], bound, body, len);
+	if(packedlen > SS_COMPRLEN_SIZE(~0))
+		return 0;
+	return packedlen;
+}
+
+bool FCEUSS_SaveMS(EMUFILE* outstream, int compressionLevel, bool thumbnail)
 {
 	// reinit memory_savestate
 	// memory_savestate is global variable which already has its vector of bytes, so no need to allocate memory every time we use save/loadstate
@@ -401,14 +758,26 @@ bool FCEUSS_SaveMS(EMUFILE* outstream, int compressionLevel)
 		}
 	}
 	// save back buffer
+	if(backBufferSavestates == SSBACKBUF_RAW)
 	{
-		extern uint8 *XBackBuf;
 		uint32 size = 256 * 256 + 8;
 		os->fputc(8);
 		write32le(size, os);
-		os->fwrite((char*)XBackBuf,size);
+		os->fwrite((char*)FCEU_GetBackBuf(),size);
 		totalsize += 5 + size;
 	}
+	else if(backBufferSavestates == SSBACKBUF_COMPRESSED)
+	{
+		uLongf size = compressBound(256 * 256);
+		if(compressed_backbuf.size() < size) compressed_backbuf.resize(size);
+		if(compress2(&compressed_backbuf[0], &size, FCEU_GetBackBuf(), 256 * 256, Z_BEST_SPEED) == Z_OK)
+		{
+			os->fputc(9);
+			write32le(size, os);
+			os->fwrite((char*)&compressed_backbuf[0],size);
+			totalsize += 5 + size;
+		}
+	}
 
 	if(SPreSave) SPreSave();
 	totalsize+=WriteStateChunk(os,0x10,SFMDATA);
@@ -424,48 +793,45 @@ bool FCEUSS_SaveMS(EMUFILE* outstream, int compressionLevel)
 		return false;
 	}
 
-	int error = Z_OK;
 	uint8* cbuf = (uint8*)memory_savestate.buf();
-	uLongf comprlen = -1;
+	uint32 cbuflen = totalsize;
+	int comprlen = -1;
 	if(compressionLevel != Z_NO_COMPRESSION && (compressSavestates || FCEUMOV_Mode(MOVIEMODE_TASEDITOR)))
 	{
-		// worst case compression: zlib says "0.1% larger than sourceLen plus 12 bytes"
-		comprlen = (len>>9)+12 + len;
-		if (compressed_buf.size() < comprlen) compressed_buf.resize(comprlen);
-		cbuf = &compressed_buf[0];
-		// do compression
-		error = compress2(cbuf, &comprlen, (uint8*)memory_savestate.buf(), len, compressionLevel);
+		uint32 packedlen = PackState(savestateCodec, compressionLevel, cbuf, len, compressed_buf);
+		if(packedlen)
+		{
+			cbuf = &compressed_buf[0];
+			cbuflen = packedlen;
+			comprlen = SS_COMPRLEN(savestateCodec, packedlen);
+		}
 	}
 
 	//dump the header
 	uint8 header[16]="FCSX";
 	FCEU_en32lsb(header+4, totalsize);
-	FCEU_en32lsb(header+8, FCEU_VERSION_NUMERIC);
+	FCEU_en32lsb(header+8, FCEU_VERSION_NUMERIC | (thumbnail ? SS_THUMBNAIL : 0));
 	FCEU_en32lsb(header+12, comprlen);
 
 	//dump it to the destination file
 	outstream->fwrite((char*)header,16);
-	outstream->fwrite((char*)cbuf,comprlen==-1?totalsize:comprlen);
+	if(thumbnail)
+	{
+		MakeThumbnail(thumbnail_buf);
+		outstream->fwrite((char*)&thumbnail_buf[0],thumbnail_buf.size());
+	}
+	outstream->fwrite((char*)cbuf,cbuflen);
 
-	return error == Z_OK;
+	return true;
 }
 
 
-void FCEUSS_Save(const char *fname, bool display_message)
+//Works out the file a state goes to (the current slot if fname is NULL) and
+//moves the slot's previous state aside for undo
+static void StateFileName(const char *fname, char *fn)
 {
-	EMUFILE* st = 0;
-	char fn[2048];
-
-	if (geniestage==1)
-	{
-		if (display_message)
-			FCEU_DispMessage("Cannot save FCS in GG screen.",0);
-		return;
-	}
-
 	if(fname)	//If filename is given use it.
 	{
-		st = FCEUD_UTF8_fstream(fname, "wb");
 		strcpy(fn, fname);
 	}
 	else		//Else, generate one
@@ -482,17 +848,11 @@ void FCEUSS_Save(const char *fname, bool display_message)
 		}
 		else
 			undoSS = false;					//so backup made so lastSavestateMade does have a backup file, so no undo
-
-		st = FCEUD_UTF8_fstream(fn,"wb");
-	}
-
-	if (st == NULL || st->get_fp() == NULL)
-	{
-		if (display_message)
-			FCEU_DispMessage("State %d save error.", 0, CurrentState);
-		return;
 	}
+}
 
+static void SaveLuaData(const char *fn)
+{
 	#ifdef _S9XLUA_H
 	if (!internalSaveLoad)
 	{
@@ -518,11 +878,39 @@ void FCEUSS_Save(const char *fname, bool display_message)
 		}
 	}
 	#endif
+}
+
+void FCEUSS_Save(const char *fname, bool display_message)
+{
+	EMUFILE* st = 0;
+	char fn[2048];
+
+	if (geniestage==1)
+	{
+		if (display_message)
+			FCEU_DispMessage("Cannot save FCS in GG screen.",0);
+		return;
+	}
+
+	//an earlier asynchronous save of the same slot must land first
+	FCEU_AsyncWait();
+
+	StateFileName(fname, fn);
+	st = FCEUD_UTF8_fstream(fn,"wb");
+
+	if (st == NULL || st->get_fp() == NULL)
+	{
+		if (display_message)
+			FCEU_DispMessage("State %d save error.", 0, CurrentState);
+		return;
+	}
+
+	SaveLuaData(fn);
 
 	if(FCEUMOV_Mode(MOVIEMODE_INACTIVE))
-		FCEUSS_SaveMS(st,-1);
+		FCEUSS_SaveMS(st,-1,thumbnailSavestates);
 	else
-		FCEUSS_SaveMS(st,0);
+		FCEUSS_SaveMS(st,0,thumbnailSavestates);
 
 	delete st;
 
@@ -535,6 +923,96 @@ void FCEUSS_Save(const char *fname, bool display_message)
 	redoSS = false;					//we have a new savestate so redo is not possible
 }
 
+static std::atomic<bool> stateWriteFailed(false);	//an asynchronous save failed since FCEUSS_WaitSaves last looked
+
+//Compresses an uncompressed FCSX image and writes it out, on the writer thread
+class STATEWRITEJOB : public ASYNCJOB
+{
+public:
+	std::string fname;
+	std::vector<uint8> state;
+	int codec;
+	int compressionLevel;
+
+	virtual void run()
+	{
+		const uint8 *data = &state[0];
+		uint32 len = state.size();
+
+		std::vector<uint8> packed;
+		if(compressionLevel != Z_NO_COMPRESSION)
+		{
+			uint32 totalsize = FCEU_de32lsb(&state[4]);
+			uint32 bodyoff = StateBodyOffset(&state[0]);
+			uint32 packedlen = PackState(codec, compressionLevel, &state[bodyoff], totalsize, packed);
+			if(packedlen)
+			{
+				//the header and thumbnail go in front of the packed body
+				packed.insert(packed.begin(), state.begin(), state.begin() + bodyoff);
+				FCEU_en32lsb(&packed[12], SS_COMPRLEN(codec, packedlen));
+				data = &packed[0];
+				len = bodyoff + packedlen;
+			}
+		}
+
+		if(!FCEU_WriteFileAtomic(fname.c_str(), data, len))
+		{
+			FCEU_printf("Couldn't write savestate %s\n", fname.c_str());
+			stateWriteFailed = true;
+		}
+	}
+};
+
+void FCEUSS_SaveAsync(const char *fname, bool display_message)
+{
+	char fn[2048];
+
+	if (geniestage==1)
+	{
+		if (display_message)
+			FCEU_DispMessage("Cannot save FCS in GG screen.",0);
+		return;
+	}
+
+	//the undo backup renames the file an earlier save may still be writing
+	if (!fname && backupSavestates)
+		FCEU_AsyncWait();
+
+	StateFileName(fname, fn);
+	SaveLuaData(fn);
+
+	STATEWRITEJOB *job = new STATEWRITEJOB();
+	job->fname = fn;
+	job->codec = savestateCodec;
+	job->compressionLevel = (FCEUMOV_Mode(MOVIEMODE_INACTIVE) && compressSavestates) ? Z_DEFAULT_COMPRESSION : Z_NO_COMPRESSION;
+
+	EMUFILE_MEMORY ms(&job->state);
+	if (!FCEUSS_SaveMS(&ms, Z_NO_COMPRESSION, thumbnailSavestates))
+	{
+		delete job;
+		if (display_message)
+			FCEU_DispMessage("State %d save error.", 0, CurrentState);
+		return;
+	}
+	job->state.resize(ms.size());
+	FCEU_AsyncSubmit(job);
+
+	if(!fname)
+		SaveStateStatus[CurrentState] = 1;
+	redoSS = false;					//we have a new savestate so redo is not possible
+}
+
+bool FCEUSS_SavePending(void)
+{
+	return FCEU_AsyncBusy();
+}
+
+bool FCEUSS_WaitSaves(void)
+{
+	FCEU_AsyncWait();
+	return !stateWriteFailed.exchange(false);
+}
+
 int FCEUSS_LoadFP_old(EMUFILE* is, ENUM_SSLOADPARAMS params)
 {
 	//if(params==SSLOADPARAM_DUMMY && suppress_scan_chunks)
@@ -629,62 +1107,137 @@ int FCEUSS_LoadFP_old(EMUFILE* is, ENUM_SSLOADPARAMS params)
 }
 
 
+//Checks that a decompressed state body is well formed (every chunk, and every
+//field inside the SFORMAT chunks, fits in its parent) before any of it is
+//applied, so a bad state is refused while the emulation is still untouched.
+//hasMovie is set if the state carries movie data, which can still be refused later.
+static bool ValidateStateChunks(uint8 *buf, uint32 totalsize, bool *hasMovie)
+{
+	uint32 pos = 0;
+	*hasMovie = false;
+	while(pos < totalsize)
+	{
+		if(totalsize - pos < 5)
+			return false;
+		int t = buf[pos];
+		uint32 size = FCEU_de32lsb(buf + pos + 1);
+		pos += 5;
+		if(size > totalsize - pos)
+			return false;
+
+		switch(t)
+		{
+		case 1: case 2: case 3: case 31: case 4: case 5: case 6: case 0x10:
+			{
+				//descriptor, size, data
+				uint8 *chunk = buf + pos;
+				uint32 p = 0;
+				while(p < size)
+				{
+					if(size - p < 8)
+						return false;
+					uint32 fsize = FCEU_de32lsb(chunk + p + 4);
+					p += 8;
+					if(fsize > size - p)
+						return false;
+					p += fsize;
+				}
+			}
+			break;
+		case 7:
+			*hasMovie = true;
+			break;
+		case 8:
+			if(size > 256 * 256 + 8)
+				return false;
+			break;
+		}
+		pos += size;
+	}
+	return true;
+}
+
 bool FCEUSS_LoadFP(EMUFILE* is, ENUM_SSLOADPARAMS params)
 {
 	if(!is) return false;
 
-	//maybe make a backup savestate
 	bool backup = (params == SSLOADPARAM_BACKUP);
-	EMUFILE_MEMORY msBackupSavestate;
-	if(backup)
-	{
-		FCEUSS_SaveMS(&msBackupSavestate,Z_NO_COMPRESSION);
-	}
 
 	uint8 header[16];
 	//read and analyze the header
 	is->fread((char*)&header,16);
 	if(memcmp(header,"FCSX",4)) {
 		//its not an fceux save file.. perhaps it is an fceu savefile
+		//these can't be checked up front, so keep a way back
+		if(backup && (!backupStateCurrent || backupStateRaw))
+			MakeBackupState(true);
 		is->fseek(0,SEEK_SET);
 		FCEU_state_loading_old_format = true;
 		bool ret = FCEUSS_LoadFP_old(is,params)!=0;
 		FCEU_state_loading_old_format = false;
-		if(!ret && backup) FCEUSS_LoadFP(&msBackupSavestate,SSLOADPARAM_NOBACKUP);
+		if(!ret && backup)
+			RestoreBackupState();
+		backupStateCurrent = false;
 		return ret;
 	}
 
 	int totalsize = FCEU_de32lsb(header + 4);
 	int stateversion = FCEU_de32lsb(header + 8);
 	int comprlen = FCEU_de32lsb(header + 12);
+	if(totalsize < 0)
+		return false;
 
-	// reinit memory_savestate
-	// memory_savestate is global variable which already has its vector of bytes, so no need to allocate memory every time we use save/loadstate
-	if ((int)(memory_savestate.get_vec())->size() < totalsize)
-		(memory_savestate.get_vec())->resize(totalsize);
-	memory_savestate.set_len(totalsize);
-	memory_savestate.unfail();
-	memory_savestate.fseek(0, SEEK_SET);
+	if(stateversion & SS_THUMBNAIL)
+	{
+		//only the menus look at the thumbnail
+		uint8 size[4];
+		if(is->fread((char*)size,4) != 4)
+			return false;
+		uint32 skip = FCEU_de32lsb(size);
+		if(skip > SS_THUMBNAIL_MAXSIZE)
+			return false;
+		is->fseek(skip,SEEK_CUR);
+		stateversion &= ~SS_THUMBNAIL;
+	}
+
+	// stage the incoming state in its own buffer; memory_savestate is where FCEUSS_SaveMS works
+	if ((int)(staging_savestate.get_vec())->size() < totalsize)
+		(staging_savestate.get_vec())->resize(totalsize);
+	staging_savestate.set_len(totalsize);
+	staging_savestate.unfail();
+	staging_savestate.fseek(0, SEEK_SET);
 
 	if(comprlen != -1)
 	{
-		// the savestate is compressed: read from is to compressed_buf, then decompress from compressed_buf to memory_savestate.vec
+		// the savestate is compressed: read from is to compressed_buf, then decompress from compressed_buf to staging_savestate.vec
+		int codec = SS_COMPRLEN_CODEC(comprlen);
+		comprlen = SS_COMPRLEN_SIZE(comprlen);
 		if ((int)compressed_buf.size() < comprlen) compressed_buf.resize(comprlen);
-		is->fread(&compressed_buf[0], comprlen);
+		if(is->fread(&compressed_buf[0], comprlen) != (size_t)comprlen)
+			return false;
 
-		uLongf uncomprlen = totalsize;
-		int error = uncompress(memory_savestate.buf(), &uncomprlen, &compressed_buf[0], comprlen);
-		if(error != Z_OK || uncomprlen != totalsize)
+		if(!FCEU_Decompress(codec, staging_savestate.buf(), totalsize, &compressed_buf[0], comprlen))
 			return false;	// we dont need to restore the backup here because we havent messed with the emulator state yet
 	} else
 	{
-		// the savestate is not compressed: just read from is to memory_savestate.vec
-		is->fread(memory_savestate.buf(), totalsize);
+		// the savestate is not compressed: just read from is to staging_savestate.vec
+		if(is->fread(staging_savestate.buf(), totalsize) != (size_t)totalsize)
+			return false;
 	}
 
+	bool hasMovie;
+	if(!ValidateStateChunks(staging_savestate.buf(), totalsize, &hasMovie))
+		return false;
+
+	//past this point only the movie code can still refuse the state; when a
+	//movie is involved, rolling back takes a full state
+	bool movie = hasMovie || !FCEUMOV_Mode(MOVIEMODE_INACTIVE);
+	if(backup && (!backupStateCurrent || (backupStateRaw && movie)))
+		MakeBackupState(movie);
+
 	FCEUMOV_PreLoad();
 
-	bool x = (ReadStateChunks(&memory_savestate, totalsize) != 0);
+	bool x = (ReadStateChunks(&staging_savestate, totalsize) != 0);
 
 	//mbg 5/24/08 - we don't support old states, so this shouldnt matter.
 	//if(read_sfcpuc && stateversion<9500)
@@ -699,11 +1252,10 @@ bool FCEUSS_LoadFP(EMUFILE* is, ENUM_SSLOADPARAMS params)
 		FCEUPPU_LoadState(stateversion);
 		FCEUSND_LoadState(stateversion);
 		x=FCEUMOV_PostLoad();
-	} else if (backup)
-	{
-		msBackupSavestate.fseek(0,SEEK_SET);
-		FCEUSS_LoadFP(&msBackupSavestate,SSLOADPARAM_NOBACKUP);
 	}
+	if (!x && backup)
+		RestoreBackupState();
+	backupStateCurrent = false;
 
 	return x;
 }
@@ -727,6 +1279,9 @@ bool FCEUSS_Load(const char *fname, bool display_message)
 			FCEU_DispMessage("Cannot load FCS in GG screen.",0);
 		return false;
 	}
+
+	//don't read a state that is still being written
+	FCEU_AsyncWait();
 	if (fname)
 	{
 		st = FCEUD_UTF8_fstream(fname, "rb");
@@ -774,6 +1329,9 @@ bool FCEUSS_Load(const char *fname, bool display_message)
 		}
 		delete st;
 
+		//the rewind input log doesn't lead to the loaded state
+		FCEU_RewindReset();
+
 		#ifdef _S9XLUA_H
 		if (!internalSaveLoad)
 		{
@@ -847,7 +1405,7 @@ void ResetExState(void (*PreSave)(void), void (*PostSave)(void))
 	for(x=0;x<SFEXINDEX;x++)
 	{
 		if(SFMDATA[x].desc)
-			free(SFMDATA[x].desc);
+			free((char *)SFMDATA[x].desc);
 	}
 	// adelikat, 3/14/09:  had to add this to clear out the size parameter.  NROM(mapper 0) games were having savestate crashes if loaded after a non NROM game	because the size variable was carrying over and causing savestates to save too much data
 	SFMDATA[0].s = 0;
@@ -855,9 +1413,11 @@ void ResetExState(void (*PreSave)(void), void (*PostSave)(void))
 	SPreSave = PreSave;
 	SPostSave = PostSave;
 	SFEXINDEX=0;
+	rawSpansValid = false;
+	InvalidateIndex(SFMDATA);
 }
 
-void AddExState(void *v, uint32 s, int type, char *desc)
+void AddExState(void *v, uint32 s, int type, const char *desc)
 {
 	if(s==~0)
 	{
@@ -884,8 +1444,9 @@ void AddExState(void *v, uint32 s, int type, char *desc)
 
 	if(desc)
 	{
-		SFMDATA[SFEXINDEX].desc=(char *)FCEU_malloc(strlen(desc)+1);
-		strcpy(SFMDATA[SFEXINDEX].desc,desc);
+		char *copy=(char *)FCEU_malloc(strlen(desc)+1);
+		strcpy(copy,desc);
+		SFMDATA[SFEXINDEX].desc=copy;
 	}
 	else
 		SFMDATA[SFEXINDEX].desc=0;
@@ -904,6 +1465,8 @@ void AddExState(void *v, uint32 s, int type, char *desc)
 		}
 	}
 	SFMDATA[SFEXINDEX].v=0;		// End marker.
+	rawSpansValid = false;
+	InvalidateIndex(SFMDATA);
 }
 
 void FCEUI_SelectStateNext(int n)
@@ -939,6 +1502,54 @@ void FCEUI_SaveState(const char *fname, bool display_message)
 	FCEUSS_Save(fname, display_message);
 }
 
+void FCEUI_SaveStateAsync(const char *fname, bool display_message)
+{
+	if(!FCEU_IsValidUI(FCEUI_SAVESTATE)) return;
+
+	StateShow = 0;
+
+	FCEUSS_SaveAsync(fname, display_message);
+}
+
+bool FCEUI_SaveStatePending(void)
+{
+	return FCEUSS_SavePending();
+}
+
+bool FCEUI_LoadStateThumbnail(const char *fname, uint16 *pixels)
+{
+	//no need to wait for the writer: a state file is only ever replaced whole
+	EMUFILE* st = FCEUD_UTF8_fstream(fname, "rb");
+	if (st == NULL || st->get_fp() == NULL)
+	{
+		delete st;
+		return false;
+	}
+
+	const uint32 len = FCEU_THUMBNAIL_WIDTH * FCEU_THUMBNAIL_HEIGHT * 2;
+	uint8 header[16 + 8];
+	bool ok = st->fread((char*)header, sizeof(header)) == sizeof(header)
+		&& !memcmp(header, "FCSX", 4)
+		&& (FCEU_de32lsb(header + 8) & SS_THUMBNAIL)
+		&& FCEU_de32lsb(header + 16) == 4 + len
+		&& FCEU_de16lsb(header + 20) == FCEU_THUMBNAIL_WIDTH
+		&& FCEU_de16lsb(header + 22) == FCEU_THUMBNAIL_HEIGHT;
+	if (ok)
+	{
+		std::vector<uint8> buf(len);
+		ok = st->fread((char*)&buf[0], len) == len;
+		for (uint32 i = 0; ok && i < len / 2; i++)
+			pixels[i] = FCEU_de16lsb(&buf[i * 2]);
+	}
+	delete st;
+	return ok;
+}
+
+bool FCEUI_WaitStateSaves(void)
+{
+	return FCEUSS_WaitSaves();
+}
+
 int loadStateFailed = 0; // hack, this function should return a value instead
 
 bool file_exists(const char * filename)
@@ -962,6 +1573,14 @@ void FCEUI_LoadState(const char *fname, bool display_message)
 	information expected in newer save states, desynchronization won't occur(at least not
 	from this ;)).
 	*/
+	if (fname != NULL && !file_exists(fname))
+	{
+		loadStateFailed = 1;
+		return; // state doesn't exist; exit cleanly
+	}
+
+	//The one snapshot a load still takes when backups are on: it is what Undo
+	//Loadstate returns to, and the load below rolls back to it if it fails
 	if (backupSavestates)
 		BackupLoadState();	// If allowed, backup the current state before loading a new one
 
@@ -969,11 +1588,6 @@ void FCEUI_LoadState(const char *fname, bool display_message)
 	{
 		FCEUI_MakeBackupMovie(false);	//Backup the movie before the contents get altered, but do not display messages
 	}
-	if (fname != NULL && !file_exists(fname))
-	{
-		loadStateFailed = 1;
-		return; // state doesn't exist; exit cleanly
-	}
 	if (FCEUSS_Load(fname, display_message))
 	{
 		//mbg todo netplay
@@ -1013,7 +1627,8 @@ void FCEU_DrawSaveStates(uint8 *XBuf)
 	if(!StateShow) return;
 
 	FCEU_DrawNumberRow(XBuf,SaveStateStatus,CurrentState);
-	StateShow--;
+	if(!FCEU_RunAheadSpeculating())
+		StateShow--;
 }
 
 //*************************************************************************
@@ -1088,66 +1703,61 @@ void SwapSaveState()
 //(Used when Loading savestates)
 //*************************************************************************
 
-string GetBackupFileName()
+static void MakeBackupState(bool full)
 {
-	//This backup savestate is a special one specifically made whenever a loadstate occurs so that the user's place in a movie/game is never lost
-	//particularly from unintentional loadstating
-	string filename;
-	int x;
-
-	filename = strdup(FCEU_MakeFName(FCEUMKF_STATE,CurrentState,0).c_str());	//Generate normal savestate filename
-	x = filename.find_last_of(".");		//Find last dot
-	filename = filename.substr(0,x);	//Chop off file extension
-	filename.append(".bak.fc0");		//add .bak
-
-	return filename;
+	backupState.set_len(0);
+	backupState.unfail();
+	backupStateRaw = !full;
+	if(full)
+		FCEUSS_SaveMS(&backupState,Z_NO_COMPRESSION);
+	else
+	{
+		uint32 size = FCEUSS_RawSize();
+		if(backupState.get_vec()->size() < size)
+			backupState.get_vec()->resize(size);
+		backupState.set_len(size);
+		FCEUSS_SaveRaw(backupState.buf());
+		backupFrame.assign(FCEU_GetBackBuf(), FCEU_GetBackBuf() + 256 * 256);
+	}
+	backupStateCurrent = true;
 }
 
-bool CheckBackupSaveStateExist()
+static void RestoreBackupState()
 {
-	//This function simply checks to see if the backup loadstate exists, the backup loadstate is a special savestate
-	//That is made before loading any state, so that the user never loses his data
-	string filename = GetBackupFileName(); //Get backup savestate filename
-
-	//Check if this filename exists
-	fstream test;
-	test.open(filename.c_str(),fstream::in);
-
-	if (test.fail())
+	if(backupStateRaw)
 	{
-		test.close();
-		return false;
+		FCEUSS_LoadRaw(backupState.buf());
+		memcpy(XBackBuf, &backupFrame[0], 256 * 256);
+		FCEU_BackBufLoaded();
 	}
 	else
 	{
-		test.close();
-		return true;
+		backupState.fseek(0,SEEK_SET);
+		FCEUSS_LoadFP(&backupState,SSLOADPARAM_NOBACKUP);
 	}
 }
 
 void BackupLoadState()
 {
-	string filename = GetBackupFileName();
-	internalSaveLoad = true;
-	FCEUSS_Save(filename.c_str());
-	internalSaveLoad = false;
+	//Kept in memory only, so unlike the old .bak.fc0 file it is gone once the
+	//game is closed. The load that follows rolls back to it if need be.
+	MakeBackupState(!FCEUMOV_Mode(MOVIEMODE_INACTIVE));
 	undoLS = true;
 }
 
 void LoadBackup()
 {
 	if (!undoLS) return;
-	string filename = GetBackupFileName();	//Get backup filename
-	if (CheckBackupSaveStateExist())
+	//a raw snapshot has no movie data to bring a movie started since back in step
+	if (backupState.size() && (!backupStateRaw || FCEUMOV_Mode(MOVIEMODE_INACTIVE)))
 	{
-		//internalSaveLoad = true;
-		FCEUSS_Load(filename.c_str());		//Load it
-		//internalSaveLoad = false;
+		RestoreBackupState();
+		FCEU_RewindReset();
 		redoLS = true;						//Flag redoLoadState
 		undoLS = false;						//Flag that LoadBackup cannot be run again
 	}
 	else
-		FCEUI_DispMessage("Error: Could not load %s",0,filename.c_str());
+		FCEUI_DispMessage("Error: no state to undo to",0);
 }
 
 void RedoLoadState()
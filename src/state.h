@@ -24,14 +24,37 @@ enum ENUM_SSLOADPARAMS
 	SSLOADPARAM_BACKUP,
 };
 
+//how the back buffer (the last frame) is stored in savestates
+enum ENUM_SSBACKBUF
+{
+	SSBACKBUF_OMIT,			//not stored, the screen is redrawn by the next frame
+	SSBACKBUF_RAW,			//chunk 8, 256*256+8 bytes
+	SSBACKBUF_COMPRESSED,	//chunk 9, zlib compressed
+};
+
 void FCEUSS_Save(const char *, bool display_message=true);
+//Takes the snapshot now; compressing and writing it happen on the background writer
+void FCEUSS_SaveAsync(const char *, bool display_message=true);
+bool FCEUSS_SavePending(void);
+bool FCEUSS_WaitSaves(void);	//false if an asynchronous save failed
 bool FCEUSS_Load(const char *, bool display_message=true);
 
  //zlib values: 0 (none) through 9 (max) or -1 (default)
-bool FCEUSS_SaveMS(EMUFILE* outstream, int compressionLevel);
+ //thumbnail puts a small picture of the screen in front of the state, for menus
+bool FCEUSS_SaveMS(EMUFILE* outstream, int compressionLevel, bool thumbnail=false);
 
 bool FCEUSS_LoadFP(EMUFILE* is, ENUM_SSLOADPARAMS params);
 
+//Raw snapshots: every registered state field copied as is, without the chunk
+//format. Only valid for the running game in the same build; no movie data and
+//no back buffer. Much faster than FCEUSS_SaveMS, for rewind and the like.
+uint32 FCEUSS_RawSize(void);
+//Identifies the field layout, to check a raw snapshot kept on disk against
+//the running build and game before loading it
+uint32 FCEUSS_RawLayout(void);
+void FCEUSS_SaveRaw(uint8 *buf);	//buf must hold FCEUSS_RawSize() bytes
+void FCEUSS_LoadRaw(const uint8 *buf);
+
 extern int CurrentState;
 void FCEUSS_CheckStates(void);
 
@@ -44,11 +67,11 @@ struct SFORMAT
 	uint32 s;
 
 	//a string description of the element
-	char *desc;
+	const char *desc;
 };
 
 void ResetExState(void (*PreSave)(void),void (*PostSave)(void));
-void AddExState(void *v, uint32 s, int type, char *desc);
+void AddExState(void *v, uint32 s, int type, const char *desc);
 
 //indicates that the value is a multibyte integer that needs to be put in the correct byte order
 #define FCEUSTATE_RLSB            0x80000000
@@ -74,6 +97,8 @@ extern char lastLoadstateMade[2048]; //Filename of last state loaded
 extern bool undoLS;					 //undo loadstate flag
 extern bool redoLS;					 //redo savestate flag
 extern bool backupSavestates;		 //Whether or not to make backups, true by default
-bool CheckBackupSaveStateExist();	 //Checks if backupsavestate exists
 
 extern bool compressSavestates;		//Whether or not to compress non-movie savestates (by default, yes)
+extern int backBufferSavestates;	//ENUM_SSBACKBUF, how to store the back buffer (by default, raw)
+extern int savestateCodec;	//ENUM_CODEC (utils/codec.h) used for compressed savestates, zlib by default
+extern bool thumbnailSavestates;	//Whether or not state files get a preview picture (by default, yes)
@@ -0,0 +1,61 @@
+#ifndef __FCEU_TEST_ARM_NEON_H
+#define __FCEU_TEST_ARM_NEON_H
+
+// Plain C stand-ins for the NEON intrinsics dingoo-ntsc.cpp uses, lane by
+// lane as the ARM reference describes them, so its NEON path can be built
+// and checked on the host. See test_ntsc_neon in the Makefile.
+
+#include <stdint.h>
+
+typedef struct { uint32_t v[2]; } uint32x2_t;
+typedef struct { uint32_t v[4]; } uint32x4_t;
+typedef struct { uint16_t v[4]; } uint16x4_t;
+
+static inline uint32x2_t vld1_u32(uint32_t const *p)
+{
+	uint32x2_t r = { { p[0], p[1] } };
+	return r;
+}
+
+static inline uint32x2_t vdup_n_u32(uint32_t x)
+{
+	uint32x2_t r = { { x, x } };
+	return r;
+}
+
+#define NEON_BINARY_(name, op) \
+static inline uint32x2_t name(uint32x2_t a, uint32x2_t b) \
+{ \
+	uint32x2_t r = { { (uint32_t)(a.v[0] op b.v[0]), (uint32_t)(a.v[1] op b.v[1]) } }; \
+	return r; \
+}
+NEON_BINARY_(vadd_u32, +)
+NEON_BINARY_(vsub_u32, -)
+NEON_BINARY_(vand_u32, &)
+NEON_BINARY_(vorr_u32, |)
+#undef NEON_BINARY_
+
+static inline uint32x2_t vshr_n_u32(uint32x2_t a, int n)
+{
+	uint32x2_t r = { { a.v[0] >> n, a.v[1] >> n } };
+	return r;
+}
+
+static inline uint32x4_t vcombine_u32(uint32x2_t lo, uint32x2_t hi)
+{
+	uint32x4_t r = { { lo.v[0], lo.v[1], hi.v[0], hi.v[1] } };
+	return r;
+}
+
+static inline uint16x4_t vmovn_u32(uint32x4_t a)
+{
+	uint16x4_t r = { { (uint16_t)a.v[0], (uint16_t)a.v[1], (uint16_t)a.v[2], (uint16_t)a.v[3] } };
+	return r;
+}
+
+static inline void vst1_lane_u16(uint16_t *p, uint16x4_t a, int lane)
+{
+	*p = a.v[lane];
+}
+
+#endif
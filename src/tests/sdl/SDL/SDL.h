@@ -0,0 +1,3 @@
+// The core includes the dingux driver header for a few plain declarations,
+// and that header includes SDL. Nothing in the core uses SDL itself, so the
+// host tests build it against this empty header instead.
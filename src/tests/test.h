@@ -0,0 +1,29 @@
+#ifndef __FCEU_TEST_H
+#define __FCEU_TEST_H
+
+// Minimal checks for the host tests. A test program runs its checks, prints
+// the ones that failed and returns TEST_RESULT() from main.
+
+#include <stdio.h>
+#include <time.h>
+
+static int test_failures = 0;
+
+#define CHECK(cond) do { \
+	if(!(cond)) { \
+		printf("%s:%d: check failed: %s\n", __FILE__, __LINE__, #cond); \
+		test_failures++; \
+	} \
+} while(0)
+
+#define TEST_RESULT() (printf(test_failures ? "FAILED (%d)\n" : "ok\n", test_failures), test_failures != 0)
+
+//microseconds on the monotonic clock, for the timings the tests print
+static inline double TestMicros(void)
+{
+	struct timespec ts;
+	clock_gettime(CLOCK_MONOTONIC, &ts);
+	return ts.tv_sec * 1e6 + ts.tv_nsec / 1e3;
+}
+
+#endif
@@ -0,0 +1,172 @@
+/* FCE Ultra - NES/Famicom Emulator
+ *
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation; either version 2 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307  USA
+ */
+
+// utils/codec: both back ends have to round trip any input, reject damaged
+// input without writing past the output, and savestates written with either
+// one have to load through the codec byte in the FCSX header.
+
+#include <string.h>
+#include <stdlib.h>
+#include <vector>
+#include <zlib.h>
+
+#include "test.h"
+#include "testcore.h"
+#include "../fceu.h"
+#include "../state.h"
+#include "../emufile.h"
+#include "../utils/codec.h"
+
+static bool RoundTrip(int codec, const std::vector<uint8> &in)
+{
+	uint32 len = in.size();
+	std::vector<uint8> packed(FCEU_CodecBound(codec, len) + 1), out(len + 1);
+	uint32 packedlen = FCEU_Compress(codec, Z_BEST_SPEED, &packed[0], packed.size() - 1, len ? &in[0] : 0, len);
+	if(!packedlen)
+		return false;
+	if(!FCEU_Decompress(codec, &out[0], len, &packed[0], packedlen))
+		return false;
+	//one size off either way is an error, not a partial success
+	if(len && FCEU_Decompress(codec, &out[0], len - 1, &packed[0], packedlen))
+		return false;
+	if(FCEU_Decompress(codec, &out[0], len + 1, &packed[0], packedlen))
+		return false;
+	FCEU_Decompress(codec, &out[0], len, &packed[0], packedlen);
+	return !len || !memcmp(&in[0], &out[0], len);
+}
+
+//Decoding damaged input must fail or at least stay inside the output buffer,
+//which is checked with a guard pattern after it.
+static bool Damaged(int codec, const std::vector<uint8> &in)
+{
+	uint32 len = in.size();
+	std::vector<uint8> packed(FCEU_CodecBound(codec, len));
+	uint32 packedlen = FCEU_Compress(codec, Z_BEST_SPEED, &packed[0], packed.size(), &in[0], len);
+	if(!packedlen)
+		return false;
+
+	std::vector<uint8> out(len + 64);
+	for(uint32 cut = 0; cut < packedlen; cut += 1 + packedlen / 64)
+	{
+		memset(&out[len], 0xA5, 64);
+		if(FCEU_Decompress(codec, &out[0], len, &packed[0], cut))
+			return false;
+		for(int i = 0; i < 64; i++)
+			if(out[len + i] != 0xA5)
+				return false;
+	}
+	for(int i = 0; i < 500; i++)
+	{
+		std::vector<uint8> bad(packed.begin(), packed.begin() + packedlen);
+		bad[rand() % packedlen] ^= 1 << (rand() % 8);
+		memset(&out[len], 0xA5, 64);
+		FCEU_Decompress(codec, &out[0], len, &bad[0], packedlen);
+		for(int j = 0; j < 64; j++)
+			if(out[len + j] != 0xA5)
+				return false;
+	}
+	return true;
+}
+
+//A savestate compressed with <codec> loads back to the machine it was taken from
+static void CheckSavestate(int codec)
+{
+	std::vector<uint8> snap(FCEUSS_RawSize()), again(snap.size());
+	FCEUSS_SaveRaw(&snap[0]);
+
+	savestateCodec = codec;
+	EMUFILE_MEMORY ms;
+	CHECK(FCEUSS_SaveMS(&ms, Z_DEFAULT_COMPRESSION));
+	uint8 *header = ms.buf();
+	CHECK(!memcmp(header, "FCSX", 4));
+	int32 comprlen = header[12] | (header[13] << 8) | (header[14] << 16) | (header[15] << 24);
+	CHECK(comprlen != -1 && (uint32)comprlen >> 24 == (uint32)codec);
+
+	for(int f = 0; f < 10; f++)
+		TestCore_Frame(JOY_A);
+	ms.fseek(0, SEEK_SET);
+	CHECK(FCEUSS_LoadFP(&ms, SSLOADPARAM_NOBACKUP));
+	FCEUSS_SaveRaw(&again[0]);
+	CHECK(again == snap);
+}
+
+int main(void)
+{
+	srand(1);
+
+	std::vector<std::vector<uint8> > inputs;
+	inputs.push_back(std::vector<uint8>());
+	inputs.push_back(std::vector<uint8>(1, 7));
+	inputs.push_back(std::vector<uint8>(3, 0));
+	inputs.push_back(std::vector<uint8>(100000, 0));	//an XOR delta of an idle frame
+	std::vector<uint8> noise(70000), mixed(200000), text;
+	for(size_t i = 0; i < noise.size(); i++)
+		noise[i] = rand();
+	for(size_t i = 0; i < mixed.size(); i++)
+		mixed[i] = (i / 3000) & 1 ? rand() : (uint8)(i / 7);
+	const char *line = "|..|..|..|..|....A...|\n";	//movie input lines
+	for(int i = 0; i < 4000; i++)
+		text.insert(text.end(), line, line + 18 + i % 6);
+	inputs.push_back(noise);
+	inputs.push_back(mixed);
+	inputs.push_back(text);
+
+	for(int codec = 0; codec < CODEC_COUNT; codec++)
+	{
+		for(size_t i = 0; i < inputs.size(); i++)
+			CHECK(RoundTrip(codec, inputs[i]));
+		CHECK(Damaged(codec, mixed));
+		CHECK(Damaged(codec, text));
+
+		//no room for the output is a failure, not an overrun
+		std::vector<uint8> small(16);
+		CHECK(!FCEU_Compress(codec, Z_BEST_SPEED, &small[0], small.size(), &noise[0], noise.size()));
+	}
+	CHECK(!FCEU_Compress(CODEC_COUNT, 0, &noise[0], 16, &noise[0], 16));
+
+	if(!TestCore_Open())
+	{
+		printf("could not start the core\n");
+		return 1;
+	}
+	for(int f = 0; f < 30; f++)
+		TestCore_Frame(f & 1 ? JOY_A : 0);
+
+	//a savestate from before the codec byte is simply a zlib one
+	CheckSavestate(CODEC_ZLIB);
+	CheckSavestate(CODEC_LZ);
+
+	//how the back ends compare on what the rewind buffer feeds them
+	const int reps = 200;
+	std::vector<uint8> packed(FCEU_CodecBound(CODEC_ZLIB, mixed.size()) + FCEU_CodecBound(CODEC_LZ, mixed.size()));
+	for(int codec = 0; codec < CODEC_COUNT; codec++)
+	{
+		uint32 packedlen = 0;
+		double t0 = TestMicros();
+		for(int i = 0; i < reps; i++)
+			packedlen = FCEU_Compress(codec, Z_BEST_SPEED, &packed[0], packed.size(), &mixed[0], mixed.size());
+		double t1 = TestMicros();
+		for(int i = 0; i < reps; i++)
+			FCEU_Decompress(codec, &mixed[0], mixed.size(), &packed[0], packedlen);
+		double t2 = TestMicros();
+		printf("%s: %u -> %u bytes, compress %.0f us, decompress %.0f us\n", codec == CODEC_LZ ? "lz" : "zlib",
+			(unsigned)mixed.size(), packedlen, (t1 - t0) / reps, (t2 - t1) / reps);
+	}
+
+	TestCore_Close();
+	return TEST_RESULT();
+}
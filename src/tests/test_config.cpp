@@ -0,0 +1,165 @@
+/* FCE Ultra - NES/Famicom Emulator
+ *
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation; either version 2 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307  USA
+ */
+
+// Config: the binary snapshot next to the config file is only used while its
+// stamp matches the file, and is only written for a file that set every
+// option; option handles are checked.
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string>
+#include <unistd.h>
+#include <utime.h>
+
+#include "test.h"
+#include "../drivers/common/configSys.h"
+
+static char dir[] = "/tmp/fceutest.XXXXXX";
+
+static Config *MakeConfig(void)
+{
+	Config *c = new Config(dir);
+	c->addOption('s', "sound", "SDL.Sound", 1);
+	c->addOption("rate", "SDL.Rate", 32000);
+	c->addOption("vol", "SDL.Vol", 0.5);
+	c->addOption("file", "SDL.File", std::string(""));
+	c->addOption("SDL.Name", std::string("abc"));
+	return c;
+}
+
+static int Rate(Config *c)
+{
+	int v = -1;
+	c->getOption("SDL.Rate", &v);
+	return v;
+}
+
+static std::string File(Config *c)
+{
+	std::string s;
+	c->getOption("SDL.File", &s);
+	return s;
+}
+
+//Gives the file an old mtime, so it counts as settled
+static void Age(const std::string &name)
+{
+	struct utimbuf ut = { 1000, 1000 };
+	utime(name.c_str(), &ut);
+}
+
+static std::string ReadText(const std::string &name)
+{
+	std::string text;
+	FILE *fp = fopen(name.c_str(), "r");
+	if(!fp)
+		return text;
+	int c;
+	while((c = fgetc(fp)) != EOF)
+		text += (char)c;
+	fclose(fp);
+	return text;
+}
+
+static bool WriteText(const std::string &name, const char *text)
+{
+	FILE *fp = fopen(name.c_str(), "w");
+	if(!fp)
+		return false;
+	fputs(text, fp);
+	return fclose(fp) == 0;
+}
+
+int main(void)
+{
+	if(!mkdtemp(dir))
+	{
+		printf("could not make a temp dir\n");
+		return 1;
+	}
+	std::string cfg = std::string(dir) + "/test.cfg", bin = cfg + ".bin";
+
+	//handles, and a handle of the wrong type
+	Config *c = MakeConfig();
+	Config::IntOption rate, bad;
+	CHECK(c->findOption("SDL.Rate", &rate) == 0);
+	CHECK(c->setOption(rate, 44100) == 0);
+	CHECK(c->findOption("SDL.File", &bad) == -1);
+	int v;
+	CHECK(c->getOption(bad, &v) == -1);
+	CHECK(c->setOption(bad, 1) == -1);
+	c->setOption("SDL.File", "x y");
+	c->setOption("SDL.Vol", 0.25);
+
+	//save writes the snapshot along with the file, and it reads back
+	CHECK(c->save(cfg) == 0);
+	CHECK(access(bin.c_str(), 0) == 0);
+	Config *d = MakeConfig();
+	d->reload(cfg);
+	double vol = 0;
+	d->getOption("SDL.Vol", &vol);
+	CHECK(Rate(d) == 44100 && File(d) == "x y" && vol == 0.25);
+
+	//a hand edit moves the stamp, so the text is read
+	CHECK(WriteText(cfg, "SDL.Rate = 22050\n"));
+	Age(cfg);
+	Config *e = MakeConfig();
+	e->reload(cfg);
+	CHECK(Rate(e) == 22050 && File(e) == "");
+
+	//that file set one option only: the others keep their values and no
+	//snapshot is written for it
+	unlink(bin.c_str());
+	Config *g = MakeConfig();
+	g->setOption("SDL.File", "zz");
+	g->reload(cfg);
+	CHECK(Rate(g) == 22050 && File(g) == "zz");
+	CHECK(access(bin.c_str(), 0) != 0);
+
+	//a complete, settled file gets a snapshot when it is read
+	CHECK(e->save(cfg) == 0);
+	Age(cfg);
+	unlink(bin.c_str());
+	Config *k = MakeConfig();
+	k->reload(cfg);
+	CHECK(access(bin.c_str(), 0) == 0);
+
+	//which is then what the next load reads: an edit that keeps the size
+	//and mtime is not seen
+	std::string text = ReadText(cfg);
+	size_t at = text.find("22050");
+	CHECK(at != std::string::npos);
+	if(at != std::string::npos)
+		text.replace(at, 5, "11025");
+	CHECK(WriteText(cfg, text.c_str()));
+	Age(cfg);
+	Config *m = MakeConfig();
+	m->reload(cfg);
+	CHECK(Rate(m) == 22050);
+
+	//a truncated snapshot is ignored
+	CHECK(truncate(bin.c_str(), 20) == 0);
+	Config *n = MakeConfig();
+	n->reload(cfg);
+	CHECK(Rate(n) == 11025 && File(n) == "");
+
+	delete c; delete d; delete e; delete g; delete k; delete m; delete n;
+	unlink(bin.c_str());
+	unlink(cfg.c_str());
+	rmdir(dir);
+	return TEST_RESULT();
+}
@@ -0,0 +1,98 @@
+/* FCE Ultra - NES/Famicom Emulator
+ *
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation; either version 2 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307  USA
+ */
+
+// Gzipped images: the size in the gzip trailer is only trusted when the data
+// really ends there, so files of several members open whole.
+
+#include <stdio.h>
+#include <vector>
+#include <algorithm>
+#include <zlib.h>
+
+#include "test.h"
+#include "testcore.h"
+#include "../fceu.h"
+#include "../file.h"
+
+static std::vector<uint8> ReadAll(const char *name)
+{
+	std::vector<uint8> data;
+	FILE *fp = fopen(name, "rb");
+	if(!fp)
+		return data;
+	int c;
+	while((c = fgetc(fp)) != EOF)
+		data.push_back(c);
+	fclose(fp);
+	return data;
+}
+
+//Writes <data> as one gzip member per part
+static bool WriteGzip(const char *name, const std::vector<uint8> &data, int parts)
+{
+	remove(name);
+	size_t start = 0;
+	for(int i = 0; i < parts; i++)
+	{
+		size_t end = data.size() * (i + 1) / parts;
+		gzFile gz = gzopen(name, "ab");
+		if(!gz)
+			return false;
+		bool ok = gzwrite(gz, &data[start], end - start) == (int)(end - start);
+		if(gzclose(gz) != Z_OK || !ok)
+			return false;
+		start = end;
+	}
+	return true;
+}
+
+//Opens <name> through FCEU_fopen and checks it reads back as <data>
+static bool OpensAs(const char *name, const std::vector<uint8> &data)
+{
+	FCEUFILE *fp = FCEU_fopen(name, 0, "rb", 0);
+	if(!fp)
+		return false;
+	std::vector<uint8> got(data.size() + 1);
+	bool ok = FCEU_fgetsize(fp) == data.size()
+		&& FCEU_fread(&got[0], 1, got.size(), fp) == data.size()
+		&& std::equal(data.begin(), data.end(), got.begin());
+	FCEU_fseek(fp, 16, SEEK_SET);
+	ok = ok && FCEU_fgetc(fp) == data[16];
+	FCEU_fclose(fp);
+	return ok;
+}
+
+int main(void)
+{
+	if(!TestCore_Open())
+	{
+		printf("could not start the core\n");
+		return 1;
+	}
+
+	std::vector<uint8> rom = ReadAll(TestCore_TempFile("test.nes"));
+	CHECK(rom.size() > 16);
+	const char *gz = TestCore_TempFile("test.nes.gz");
+	for(int parts = 1; parts <= 3; parts++)
+	{
+		CHECK(WriteGzip(gz, rom, parts));
+		CHECK(OpensAs(gz, rom));
+	}
+
+	TestCore_Close();
+	return TEST_RESULT();
+}
@@ -0,0 +1,176 @@
+/* FCE Ultra - NES/Famicom Emulator
+ *
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation; either version 2 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307  USA
+ */
+
+// Loading and saving states: undoing a load, a damaged state refused with the
+// emulation left as it was, the back buffer a state stores kept free of
+// overlays across skipped frames, and a failed background save reported by
+// FCEUSS_WaitSaves even after something else waited for the writer.
+
+#include <stdio.h>
+#include <string.h>
+#include <vector>
+
+#include "test.h"
+#include "testcore.h"
+#include "../fceu.h"
+#include "../driver.h"
+#include "../state.h"
+#include "../emufile.h"
+#include "../video.h"
+#include "../utils/asyncio.h"
+
+static std::vector<uint8> Snapshot(void)
+{
+	std::vector<uint8> snap(FCEUSS_RawSize());
+	FCEUSS_SaveRaw(&snap[0]);
+	return snap;
+}
+
+static void Run(int frames)
+{
+	for(int f = 0; f < frames; f++)
+		TestCore_Frame(f & 1 ? JOY_A : 0);
+}
+
+static bool WriteFile(const char *name, const std::vector<uint8> &data)
+{
+	FILE *fp = fopen(name, "wb");
+	if(!fp)
+		return false;
+	bool ok = fwrite(&data[0], 1, data.size(), fp) == data.size();
+	fclose(fp);
+	return ok;
+}
+
+static bool BackBufIs(const std::vector<uint8> &frame)
+{
+	return !memcmp(FCEU_GetBackBuf(), &frame[0], frame.size());
+}
+
+static void TestBackBuf(void)
+{
+	//a frame drawn with a message: XBuf has it, the back buffer doesn't
+	FCEU_DispMessage("overlay", 0);
+	TestCore_Frame(0);
+	std::vector<uint8> clean(FCEU_GetBackBuf(), FCEU_GetBackBuf() + 256 * 240);
+	CHECK(memcmp(XBuf, &clean[0], clean.size()));
+
+	//a skipped frame leaves that XBuf as it was, message and all
+	uint8 *gfx;
+	int32 *sound, ssize;
+	FCEUI_Emulate(&gfx, &sound, &ssize, 1);
+	CHECK(BackBufIs(clean));
+
+	//so the state stores the clean frame
+	EMUFILE_MEMORY ms;
+	CHECK(FCEUSS_SaveMS(&ms, 0));
+	Run(3);
+	ms.fseek(0, SEEK_SET);
+	CHECK(FCEUSS_LoadFP(&ms, SSLOADPARAM_NOBACKUP));
+	CHECK(BackBufIs(clean));
+}
+
+static void TestSaveFailure(void)
+{
+	//no such directory, so the writer thread fails to write it
+	FCEUSS_SaveAsync(TestCore_TempFile("missing/x.fc0"), false);
+	FCEU_AsyncWait();
+	CHECK(!FCEUSS_WaitSaves());
+	CHECK(FCEUSS_WaitSaves());
+
+	FCEUSS_SaveAsync(TestCore_TempFile("async.fc0"), false);
+	CHECK(FCEUSS_WaitSaves());
+}
+
+int main(void)
+{
+	if(!TestCore_Open())
+	{
+		printf("could not start the core\n");
+		return 1;
+	}
+	compressSavestates = false;
+	backupSavestates = true;
+
+	Run(20);
+	const char *saved = TestCore_TempFile("saved.fc0");
+	FCEUSS_Save(saved, false);
+	std::vector<uint8> atSave = Snapshot();
+
+	Run(20);
+	std::vector<uint8> beforeLoad = Snapshot();
+	CHECK(beforeLoad != atSave);
+	//the test ROM draws the same picture every frame; make this one differ
+	memset(XBuf, 0x21, 256 * 240);
+	std::vector<uint8> frame(FCEU_GetBackBuf(), FCEU_GetBackBuf() + 256 * 240);
+
+	//load, then undo the load
+	FCEUI_LoadState(saved, false);
+	CHECK(Snapshot() == atSave);
+	CHECK(!BackBufIs(frame));
+	CHECK(undoLS);
+	LoadBackup();
+	CHECK(Snapshot() == beforeLoad);
+	CHECK(BackBufIs(frame));
+	CHECK(redoLS && !undoLS);
+
+	//damaged states are refused and leave the machine alone
+	EMUFILE_MEMORY ms;
+	CHECK(FCEUSS_SaveMS(&ms, 0));
+	std::vector<uint8> good(ms.buf(), ms.buf() + ms.size());
+	uint32 body = 16;
+	if(good[11] & 0x40)	//SS_THUMBNAIL: skip the thumbnail block
+		body += 4 + (good[body] | (good[body + 1] << 8) | (good[body + 2] << 16) | (good[body + 3] << 24));
+
+	Run(7);
+	std::vector<uint8> current = Snapshot();
+
+	std::vector<uint8> oversized = good;
+	oversized[body + 1] = oversized[body + 2] = oversized[body + 3] = oversized[body + 4] = 0xFF;
+	const char *bad = TestCore_TempFile("bad.fc0");
+	CHECK(WriteFile(bad, oversized));
+	CHECK(!FCEUSS_Load(bad, false));
+	CHECK(Snapshot() == current);
+
+	std::vector<uint8> truncated(good.begin(), good.begin() + good.size() / 2);
+	CHECK(WriteFile(bad, truncated));
+	CHECK(!FCEUSS_Load(bad, false));
+	CHECK(Snapshot() == current);
+
+	TestBackBuf();
+	TestSaveFailure();
+
+	//what the rollback costs on top of a load
+	const int reps = 1000;
+	double t0 = TestMicros();
+	for(int i = 0; i < reps; i++)
+	{
+		ms.fseek(0, SEEK_SET);
+		FCEUSS_LoadFP(&ms, SSLOADPARAM_NOBACKUP);
+	}
+	double t1 = TestMicros();
+	for(int i = 0; i < reps; i++)
+	{
+		ms.fseek(0, SEEK_SET);
+		FCEUSS_LoadFP(&ms, SSLOADPARAM_BACKUP);
+	}
+	double t2 = TestMicros();
+	printf("load %.1f us, with a rollback snapshot %.1f us\n", (t1 - t0) / reps, (t2 - t1) / reps);
+
+	TestCore_Close();
+	return TEST_RESULT();
+}
@@ -0,0 +1,159 @@
+/* FCE Ultra - NES/Famicom Emulator
+ *
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation; either version 2 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307  USA
+ */
+
+// Movies: the column store behind MovieData::records, including the
+// records[frame] accessor the Windows TAS editor edits through, fetching
+// records ahead of playback, and seeking with the movie state cache.
+
+#include <vector>
+
+#include "test.h"
+#include "testcore.h"
+#include "../fceu.h"
+#include "../driver.h"
+#include "../movie.h"
+
+static void TestRecordList(void)
+{
+	MovieRecordList records;
+	records.resize(10);
+	CHECK(records.size() == 10);
+
+	//edits in place, the way the TAS editor makes them
+	records[3].joysticks[0] |= JOY_A;
+	records[3].setBit(1, 2);
+	records[4].toggleBit(0, 7);
+	records[5].commands = MOVIECMD_RESET;
+	CHECK(records.joystick(3, 0) == JOY_A);
+	CHECK(records[3].checkBit(1, 2) && !records[3].checkBit(1, 3));
+	CHECK(records.get(4).joysticks[0] == 0x80);
+	CHECK(records[5].commands == MOVIECMD_RESET);
+	CHECK(records.get(5).command_reset());
+	CHECK(records[6].commands == 0);
+
+	//whole records, both ways
+	MovieRecord mr = records[3];
+	CHECK(mr.joysticks[0] == JOY_A && mr.joysticks[1] == 4);
+	records[7] = mr;
+	CHECK(records.get(7).joysticks[1] == 4);
+	records[8] = records[5];
+	CHECK(records[8].commands == MOVIECMD_RESET);
+	records[8].clear();
+	CHECK(records[8].commands == 0 && records.joystick(8, 0) == 0);
+	records[5].commands = 0;
+	CHECK(!records.get(5).command_reset());
+
+	//the side tables move with the joypad column
+	records[6].commands = MOVIECMD_POWER;
+	records.insert(2, 3);
+	CHECK(records.size() == 13);
+	CHECK(records.joystick(6, 0) == JOY_A);
+	CHECK(records[9].commands == MOVIECMD_POWER);
+	records.erase(0, 4);
+	CHECK(records.joystick(2, 0) == JOY_A);
+	CHECK(records[5].commands == MOVIECMD_POWER);
+	records.resize(5);
+	records.resize(8);
+	CHECK(records[5].commands == 0);
+
+	const MovieRecordList &ro = records;
+	CHECK(ro[2].joysticks[0] == JOY_A);
+}
+
+struct FRAMERAM
+{
+	uint8 frames, presses;
+	bool operator==(const FRAMERAM &o) const { return frames == o.frames && presses == o.presses; }
+};
+
+static FRAMERAM Ram(void)
+{
+	FRAMERAM r = { TestCore_Peek(0x00), TestCore_Peek(0x01) };
+	return r;
+}
+
+static bool SeekAndCheck(int frame, const std::vector<FRAMERAM> &expect)
+{
+	if(!FCEUMOV_SeekTo(frame))
+		return false;
+	return FCEUMOV_GetFrame() == frame && Ram() == expect[frame];
+}
+
+static void TestSeek(void)
+{
+	const int length = 200;
+	FCEUI_SetMovieCache(30, 1 << 20);
+
+	//record a movie, noting what the RAM holds after every frame
+	const char *fname = TestCore_TempFile("seek.fm2");
+	FCEUI_SaveMovie(fname, MOVIE_FLAG_FROM_POWERON, L"");
+	std::vector<FRAMERAM> expect(length + 1);
+	expect[0] = Ram();
+	for(int f = 0; f < length; f++)
+	{
+		TestCore_Frame(f % 5 < 2 ? JOY_A : 0);
+		CHECK(FCEUMOV_GetFrame() == f + 1);
+		expect[f + 1] = Ram();
+	}
+	FCEUI_StopMovie();
+
+	CHECK(FCEUI_LoadMovie(fname, true, 0));
+	//the file is read as playback goes: a fetch reads ahead, past the end fails
+	CHECK(FCEUMOV_FetchRecord(120) && currMovieData.records.joystick(120, 0) == JOY_A);
+	CHECK(!FCEUMOV_FetchRecord(length));
+	for(int f = 0; f < 150; f++)
+		TestCore_Frame(0);
+	CHECK(FCEUMOV_GetFrame() == 150 && Ram() == expect[150]);
+
+	//backward across cached states, forward, back to the start
+	CHECK(SeekAndCheck(148, expect));
+	CHECK(SeekAndCheck(100, expect));
+	CHECK(SeekAndCheck(61, expect));
+	CHECK(SeekAndCheck(130, expect));
+	CHECK(SeekAndCheck(1, expect));
+	CHECK(SeekAndCheck(0, expect));
+	CHECK(SeekAndCheck(length, expect));
+
+	//the rewind key: two frames back per press, all the way
+	int presses = 0;
+	double t0 = TestMicros();
+	for(int f = length; f >= 2; f -= 2, presses++)
+		if(!SeekAndCheck(f - 2, expect))
+		{
+			CHECK(!"rewind step");
+			break;
+		}
+	double t1 = TestMicros();
+	printf("rewinding by 2 frames: %.0f us a press\n", (t1 - t0) / presses);
+
+	FCEUI_StopMovie();
+	FCEUI_SetMovieCache(0, 0);
+}
+
+int main(void)
+{
+	TestRecordList();
+
+	if(!TestCore_Open())
+	{
+		printf("could not start the core\n");
+		return 1;
+	}
+	TestSeek();
+	TestCore_Close();
+	return TEST_RESULT();
+}
@@ -0,0 +1,88 @@
+/* FCE Ultra - NES/Famicom Emulator
+ *
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation; either version 2 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307  USA
+ */
+
+// dingoo_ntsc_blit16 against the stock nes_ntsc_blit. The stock blitter runs
+// at 32 bits and its output is truncated to RGB565, which is what the 16-bit
+// row macros produce, so the two must match exactly. test_ntsc checks the
+// scalar path on the host, and test_ntsc_neon the NEON one through the
+// intrinsics in neon/arm_neon.h, so both paths match the same reference and
+// each other. Built with the device toolchain test_ntsc runs the real NEON
+// path; the timings it prints are the numbers to compare with --blitbench.
+
+#include <stdlib.h>
+#include <string.h>
+#include <vector>
+
+#include "test.h"
+#include "../drivers/dingux-sdl/dingoo-ntsc.h"
+
+#define W	256
+#define H	240
+
+static uint16 To565(uint32 rgb)
+{
+	return ((rgb >> 8) & 0xF800) | ((rgb >> 5) & 0x07E0) | ((rgb >> 3) & 0x001F);
+}
+
+int main(void)
+{
+	static nes_ntsc_t ntsc;
+	nes_ntsc_init(&ntsc, &nes_ntsc_composite, 4);
+
+	std::vector<uint8> in(W * H);
+	std::vector<uint32> ref(DINGOO_NTSC_OUT_WIDTH * H);
+	std::vector<uint16> out(DINGOO_NTSC_OUT_WIDTH * H);
+
+	srand(1);
+	for(int i = 0; i < W * H; i++)
+		in[i] = rand() & 0xFF;	//the blitters mask off the high bits themselves
+
+	for(int emphasis = 0; emphasis < 8; emphasis++)
+	{
+		for(int phase = 0; phase < nes_ntsc_burst_count; phase++)
+		{
+			nes_ntsc_blit(&ntsc, &in[0], W, phase, emphasis << 6, W, H, &ref[0], DINGOO_NTSC_OUT_WIDTH * 4);
+			dingoo_ntsc_blit16(&ntsc, &in[0], W, phase, emphasis << 6, W, H, &out[0], DINGOO_NTSC_OUT_WIDTH * 2);
+
+			int bad = 0;
+			for(int i = 0; i < DINGOO_NTSC_OUT_WIDTH * H; i++)
+				if(out[i] != To565(ref[i]))
+					bad++;
+			CHECK(bad == 0);
+		}
+	}
+
+	//a few frames for the timing; the stock blitter is the baseline
+	const int frames = 60;
+	double t0 = TestMicros();
+	for(int f = 0; f < frames; f++)
+		nes_ntsc_blit(&ntsc, &in[0], W, f % 3, 0, W, H, &ref[0], DINGOO_NTSC_OUT_WIDTH * 4);
+	double t1 = TestMicros();
+	for(int f = 0; f < frames; f++)
+		dingoo_ntsc_blit16(&ntsc, &in[0], W, f % 3, 0, W, H, &out[0], DINGOO_NTSC_OUT_WIDTH * 2);
+	double t2 = TestMicros();
+
+#ifdef __ARM_NEON__
+	const char *path = "neon";
+#else
+	const char *path = "scalar";
+#endif
+	printf("nes_ntsc_blit: %.0f us/frame, dingoo_ntsc_blit16 (%s): %.0f us/frame\n",
+		(t1 - t0) / frames, path, (t2 - t1) / frames);
+
+	return TEST_RESULT();
+}
@@ -0,0 +1,113 @@
+/* FCE Ultra - NES/Famicom Emulator
+ *
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation; either version 2 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307  USA
+ */
+
+// FCEUSS_SaveRaw/FCEUSS_LoadRaw: a raw snapshot has to bring the machine back
+// exactly, so emulating on from it repeats the same frames bit for bit, and it
+// has to agree with what a regular savestate restores.
+
+#include <string.h>
+#include <vector>
+
+#include "test.h"
+#include "testcore.h"
+#include "../fceu.h"
+#include "../state.h"
+#include "../video.h"
+#include "../emufile.h"
+
+static uint8 Pattern(int frame)
+{
+	return (frame % 3 == 0) ? JOY_A : 0;
+}
+
+int main(void)
+{
+	if(!TestCore_Open())
+	{
+		printf("could not start the core\n");
+		return 1;
+	}
+
+	for(int f = 0; f < 30; f++)
+		TestCore_Frame(Pattern(f));
+
+	uint32 size = FCEUSS_RawSize();
+	CHECK(size > 0x800);	//at least the RAM
+	CHECK(FCEUSS_RawLayout() != 0);
+
+	std::vector<uint8> snap(size), again(size);
+	FCEUSS_SaveRaw(&snap[0]);
+	uint8 frames = TestCore_Peek(0x00), presses = TestCore_Peek(0x01);
+	CHECK(frames > 0 && presses > 0);
+
+	//the reference run, after the snapshot
+	for(int f = 30; f < 60; f++)
+		TestCore_Frame(Pattern(f));
+	CHECK(TestCore_Peek(0x00) == frames + 30);
+	CHECK(TestCore_Peek(0x01) == presses + 10);
+	std::vector<uint8> ram(RAM, RAM + 0x800);
+	std::vector<uint8> frame(XBuf, XBuf + 256 * 240);
+	std::vector<uint8> after(size);
+	FCEUSS_SaveRaw(&after[0]);
+
+	//back to the snapshot: the same state, and the same frames from there on
+	FCEUSS_LoadRaw(&snap[0]);
+	CHECK(TestCore_Peek(0x00) == frames && TestCore_Peek(0x01) == presses);
+	FCEUSS_SaveRaw(&again[0]);
+	CHECK(again == snap);
+
+	for(int f = 30; f < 60; f++)
+		TestCore_Frame(Pattern(f));
+	CHECK(!memcmp(&ram[0], RAM, 0x800));
+	CHECK(!memcmp(&frame[0], XBuf, 256 * 240));
+	FCEUSS_SaveRaw(&again[0]);
+	CHECK(again == after);
+
+	//a regular savestate taken at the same point restores the same machine
+	FCEUSS_LoadRaw(&snap[0]);
+	EMUFILE_MEMORY ms;
+	CHECK(FCEUSS_SaveMS(&ms, 0));
+	for(int f = 0; f < 10; f++)
+		TestCore_Frame(JOY_A);
+	ms.fseek(0, SEEK_SET);
+	CHECK(FCEUSS_LoadFP(&ms, SSLOADPARAM_NOBACKUP));
+	FCEUSS_SaveRaw(&again[0]);
+	CHECK(again == snap);
+
+	//timing of the round trip, the reason the raw format exists
+	const int reps = 1000;
+	double t0 = TestMicros();
+	for(int i = 0; i < reps; i++)
+	{
+		FCEUSS_SaveRaw(&again[0]);
+		FCEUSS_LoadRaw(&again[0]);
+	}
+	double t1 = TestMicros();
+	for(int i = 0; i < reps; i++)
+	{
+		EMUFILE_MEMORY chunk;
+		FCEUSS_SaveMS(&chunk, 0);
+		chunk.fseek(0, SEEK_SET);
+		FCEUSS_LoadFP(&chunk, SSLOADPARAM_NOBACKUP);
+	}
+	double t2 = TestMicros();
+	printf("raw snapshot %u bytes: save+load %.1f us, chunked savestate %.1f us\n",
+		size, (t1 - t0) / reps, (t2 - t1) / reps);
+
+	TestCore_Close();
+	return TEST_RESULT();
+}
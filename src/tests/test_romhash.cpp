@@ -0,0 +1,57 @@
+/* FCE Ultra - NES/Famicom Emulator
+ *
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation; either version 2 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307  USA
+ */
+
+// The ROM hash cache: loading a plain .nes stores its hashes through the
+// background writer, and the next lookup of the same file finds them.
+
+#include <string.h>
+
+#include "test.h"
+#include "testcore.h"
+#include "../fceu.h"
+#include "../file.h"
+#include "../git.h"
+#include "../utils/asyncio.h"
+
+extern uint32 iNESGameCRC32;
+
+int main(void)
+{
+	if(!TestCore_Open())
+	{
+		printf("could not start the core\n");
+		return 1;
+	}
+
+	//the load only queued the write
+	FCEU_AsyncWait();
+
+	FCEUFILE *fp = FCEU_fopen(TestCore_TempFile("test.nes"), 0, "rb", 0);
+	CHECK(fp != NULL);
+	if(fp)
+	{
+		uint8 md5[16];
+		uint32 crc = 0;
+		CHECK(FCEU_LookupROMHash(fp, md5, &crc));
+		CHECK(crc == iNESGameCRC32);
+		CHECK(!memcmp(md5, GameInfo->MD5.data, 16));
+		FCEU_fclose(fp);
+	}
+
+	TestCore_Close();
+	return TEST_RESULT();
+}
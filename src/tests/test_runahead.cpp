@@ -0,0 +1,85 @@
+/* FCE Ultra - NES/Famicom Emulator
+ *
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation; either version 2 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307  USA
+ */
+
+// Run-ahead: with it on, the real timeline, the lag counter and the message
+// timer have to come out exactly as without it.
+
+#include <string.h>
+#include <vector>
+
+#include "test.h"
+#include "testcore.h"
+#include "../fceu.h"
+#include "../driver.h"
+#include "../state.h"
+#include "../video.h"
+#include "../input.h"
+
+struct RUNRESULT
+{
+	std::vector<uint8> state;
+	unsigned int lag;
+	int howlong;
+};
+
+//Runs 40 frames from <start>, lagging on every fourth one
+static RUNRESULT Run(const std::vector<uint8> &start, int runAhead)
+{
+	FCEUSS_LoadRaw(&start[0]);
+	lagCounter = 0;
+	FCEU_DispMessage("test", 0);
+	FCEUI_SetRunAhead(runAhead, false);
+	for(int f = 0; f < 40; f++)
+	{
+		TestCore_Poke(0x02, f % 4 == 3);
+		TestCore_Frame(f % 3 ? JOY_A : 0);
+	}
+	FCEUI_SetRunAhead(0, false);
+
+	RUNRESULT r;
+	r.state.resize(FCEUSS_RawSize());
+	FCEUSS_SaveRaw(&r.state[0]);
+	r.lag = lagCounter;
+	r.howlong = guiMessage.howlong;
+	return r;
+}
+
+int main(void)
+{
+	if(!TestCore_Open())
+	{
+		printf("could not start the core\n");
+		return 1;
+	}
+	for(int f = 0; f < 10; f++)
+		TestCore_Frame(0);
+	std::vector<uint8> start(FCEUSS_RawSize());
+	FCEUSS_SaveRaw(&start[0]);
+
+	RUNRESULT plain = Run(start, 0);
+	CHECK(plain.lag >= 9);
+	for(int frames = 1; frames <= 3; frames++)
+	{
+		RUNRESULT ahead = Run(start, frames);
+		CHECK(ahead.state == plain.state);
+		CHECK(ahead.lag == plain.lag);
+		CHECK(ahead.howlong == plain.howlong);
+	}
+
+	TestCore_Close();
+	return TEST_RESULT();
+}
@@ -0,0 +1,211 @@
+/* FCE Ultra - NES/Famicom Emulator
+ *
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation; either version 2 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307  USA
+ */
+
+// The test program and the driver side of the core for the host tests: the
+// FCEUD_* callbacks and the globals the dingux driver normally provides.
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <unistd.h>
+#include <dirent.h>
+#include <list>
+#include <string>
+#include <vector>
+
+#include "testcore.h"
+#include "../fceu.h"
+#include "../driver.h"
+#include "../file.h"
+#include "../git.h"
+
+static const uint8 reset[] = {
+	0x78,				//SEI
+	0xD8,				//CLD
+	0xA2, 0xFF,			//LDX #$FF
+	0x9A,				//TXS
+	0xA9, 0x00,			//LDA #0
+	0x85, 0x00,			//STA $00
+	0x85, 0x01,			//STA $01
+	0x85, 0x02,			//STA $02
+	0xA9, 0x80,			//LDA #$80
+	0x8D, 0x00, 0x20,	//STA $2000 (NMI on)
+	0x4C, 0x12, 0xC0,	//JMP $C012
+};
+
+static const uint8 nmi[] = {
+	0xE6, 0x00,			//INC $00
+	0xA5, 0x02,			//LDA $02
+	0xD0, 0x14,			//BNE +20 (lag frame)
+	0xA9, 0x01,			//LDA #1
+	0x8D, 0x16, 0x40,	//STA $4016
+	0xA9, 0x00,			//LDA #0
+	0x8D, 0x16, 0x40,	//STA $4016
+	0xAD, 0x16, 0x40,	//LDA $4016 (A button)
+	0x29, 0x01,			//AND #1
+	0x18,				//CLC
+	0x65, 0x01,			//ADC $01
+	0x85, 0x01,			//STA $01
+	0x40,				//RTI
+};
+
+static char tempDir[64];
+static std::list<std::string> tempFiles;	//a list, so the names handed out stay put
+static uint32 joy = 0;
+
+const char *TestCore_TempFile(const char *name)
+{
+	tempFiles.push_back(std::string(tempDir) + "/" + name);
+	return tempFiles.back().c_str();
+}
+
+bool TestCore_Open(void)
+{
+	strcpy(tempDir, "/tmp/fceutest.XXXXXX");
+	if(!mkdtemp(tempDir))
+		return false;
+
+	//NROM-128: 16KB PRG mirrored at $8000 and $C000, 8KB CHR
+	std::vector<uint8> rom(16 + 16384 + 8192, 0);
+	memcpy(&rom[0], "NES\x1a\x01\x01", 6);
+	memcpy(&rom[16], reset, sizeof(reset));
+	memcpy(&rom[16 + 0x20], nmi, sizeof(nmi));
+	static const uint8 vectors[] = { 0x20, 0xC0, 0x00, 0xC0, 0x00, 0xC0 };
+	memcpy(&rom[16 + 0x3FFA], vectors, sizeof(vectors));
+
+	const char *romname = TestCore_TempFile("test.nes");
+	FILE *fp = fopen(romname, "wb");
+	if(!fp)
+		return false;
+	fwrite(&rom[0], 1, rom.size(), fp);
+	fclose(fp);
+
+	if(!FCEUI_Initialize())
+		return false;
+	FCEUI_SetBaseDirectory(tempDir);
+	FCEUI_Sound(0);
+	if(!FCEUI_LoadGame(romname, 1, true))
+		return false;
+	FCEUI_SetInput(0, SI_GAMEPAD, &joy, 0);
+	return true;
+}
+
+void TestCore_Close(void)
+{
+	FCEUI_CloseGame();
+	FCEUI_Kill();
+	//the tests' files and whatever the core wrote there (the ROM hash cache)
+	if(DIR *dir = opendir(tempDir))
+	{
+		while(struct dirent *e = readdir(dir))
+			if(strcmp(e->d_name, ".") && strcmp(e->d_name, ".."))
+				unlink((std::string(tempDir) + "/" + e->d_name).c_str());
+		closedir(dir);
+	}
+	tempFiles.clear();
+	rmdir(tempDir);
+}
+
+void TestCore_Frame(uint8 buttons)
+{
+	uint8 *gfx;
+	int32 *sound;
+	int32 ssize;
+
+	joy = buttons;
+	FCEUI_Emulate(&gfx, &sound, &ssize, 0);
+}
+
+uint8 TestCore_Peek(uint16 addr)
+{
+	return RAM[addr & 0x7FF];
+}
+
+void TestCore_Poke(uint16 addr, uint8 value)
+{
+	RAM[addr & 0x7FF] = value;
+}
+
+// Driver side ----------------------------------------------------------------
+
+int dendy = 0;
+int pal_emulation = 0;
+bool swapDuty = false;
+bool paldeemphswap = false;
+bool turbo = false;
+int closeFinishedMovie = 0;
+int showfps = 0;
+
+FILE *FCEUD_UTF8fopen(const char *fn, const char *mode) { return fopen(fn, mode); }
+EMUFILE_FILE *FCEUD_UTF8_fstream(const char *fn, const char *m)
+{
+	EMUFILE_FILE *f = new EMUFILE_FILE(fn, m);
+	if(!f->is_open())
+	{
+		delete f;
+		return 0;
+	}
+	return f;
+}
+FCEUFILE *FCEUD_OpenArchiveIndex(ArchiveScanRecord &asr, std::string &fname, int innerIndex) { return 0; }
+FCEUFILE *FCEUD_OpenArchive(ArchiveScanRecord &asr, std::string &fname, std::string *innerFilename) { return 0; }
+ArchiveScanRecord FCEUD_ScanArchive(std::string fname) { return ArchiveScanRecord(); }
+
+const char *FCEUD_GetCompilerString() { return "host test"; }
+uint64 FCEUD_GetTime() { return 0; }
+uint64 FCEUD_GetTimeFreq(void) { return 1000; }
+void FCEUD_SetPalette(uint8 index, uint8 r, uint8 g, uint8 b) {}
+void FCEUD_GetPalette(uint8 i, uint8 *r, uint8 *g, uint8 *b) { *r = *g = *b = 0; }
+void FCEUD_PrintError(const char *s) { printf("error: %s\n", s); }
+void FCEUD_Message(const char *s) {}
+int FCEUD_SendData(void *data, uint32 len) { return 0; }
+int FCEUD_RecvData(void *data, uint32 len) { return 0; }
+void FCEUD_NetplayText(uint8 *text) {}
+void FCEUD_NetworkClose(void) {}
+void FCEUD_SoundToggle(void) {}
+void FCEUD_SoundVolumeAdjust(int) {}
+void FCEUD_SaveStateAs(void) {}
+void FCEUD_LoadStateFrom(void) {}
+void FCEUD_SetInput(bool fourscore, bool microphone, ESI port0, ESI port1, ESIFC fcexp) {}
+void FCEUD_MovieRecordTo(void) {}
+void FCEUD_MovieReplayFrom(void) {}
+bool FCEUD_ShouldDrawInputAids() { return false; }
+void FCEUD_AviRecordTo(void) {}
+void FCEUD_AviStop(void) {}
+void FCEUD_SetEmulationSpeed(int cmd) {}
+void FCEUD_TurboOn(void) {}
+void FCEUD_TurboOff(void) {}
+void FCEUD_TurboToggle(void) {}
+int FCEUD_ShowStatusIcon(void) { return 0; }
+void FCEUD_ToggleStatusIcon(void) {}
+void FCEUD_HideMenuToggle(void) {}
+bool FCEUD_PauseAfterPlayback() { return false; }
+void FCEUD_VideoChanged() {}
+
+bool FCEUI_AviIsRecording() { return false; }
+bool FCEUI_AviEnableHUDrecording() { return false; }
+bool FCEUI_AviDisableMovieMessages() { return true; }
+void FCEUI_AviVideoUpdate(const unsigned char *buffer) {}
+void FCEUI_UseInputPreset(int preset) {}
+
+unsigned int *GetKeyboard(void)
+{
+	static unsigned int keys[256];
+	return keys;
+}
+void GetMouseData(uint32 (&d)[3]) { d[0] = d[1] = d[2] = 0; }
+void RefreshThrottleFPS(void) {}
@@ -0,0 +1,26 @@
+#ifndef __FCEU_TESTCORE_H
+#define __FCEU_TESTCORE_H
+
+// Runs the emulator core without a driver, on a tiny NROM program written
+// for the tests. Every frame its NMI handler
+//   - increments $00
+//   - reads the first controller and adds its A button (0 or 1) to $01,
+//     unless $02 is nonzero, which makes it a lag frame
+// so the RAM tells how many frames ran and what input they saw.
+
+#include "../types.h"
+
+//Initializes the core and loads the test program. Returns false on failure.
+bool TestCore_Open(void);
+void TestCore_Close(void);
+
+//Runs one frame with <buttons> held on the first controller (JOY_* bits)
+void TestCore_Frame(uint8 buttons);
+
+uint8 TestCore_Peek(uint16 addr);
+void TestCore_Poke(uint16 addr, uint8 value);
+
+//A file name in the temp directory, which TestCore_Close empties
+const char *TestCore_TempFile(const char *name);
+
+#endif
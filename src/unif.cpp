@@ -45,13 +45,13 @@ typedef struct {
 } UNIF_HEADER;
 
 typedef struct {
-	char *name;
+	const char *name;
 	void (*init)(CartInfo *);
 	int flags;
 } BMAPPING;
 
 typedef struct {
-	char *name;
+	const char *name;
 	int (*init)(FCEUFILE *fp);
 } BFMAPPING;
 
@@ -85,14 +85,14 @@ static int FixRomSize(uint32 size, uint32 minimum) {
 static void FreeUNIF(void) {
 	int x;
 	if (UNIFchrrama) {
-		free(UNIFchrrama); UNIFchrrama = 0;
+		FCEU_gfree(UNIFchrrama); UNIFchrrama = 0;
 	}
 	if (boardname) {
 		free(boardname); boardname = 0;
 	}
 	for (x = 0; x < 32; x++) {
 		if (malloced[x]) {
-			free(malloced[x]); malloced[x] = 0;
+			FCEU_gfree(malloced[x]); malloced[x] = 0;
 		}
 	}
 }
@@ -128,7 +128,7 @@ static int DoMirroring(FCEUFILE *fp) {
 			return(0);
 		mirrortodo = t;
 		{
-			static char *stuffo[6] = { "Horizontal", "Vertical", "$2000", "$2400", "\"Four-screen\"", "Controlled by Mapper Hardware" };
+			static const char *stuffo[6] = { "Horizontal", "Vertical", "$2000", "$2400", "\"Four-screen\"", "Controlled by Mapper Hardware" };
 			if (t < 6)
 				FCEU_printf(" Name/Attribute Table Mirroring: %s\n", stuffo[t]);
 		}
@@ -189,7 +189,7 @@ static int DINF(FCEUFILE *fp) {
 	FCEU_printf(" Dumped by: %s\n", name);
 	FCEU_printf(" Dumped with: %s\n", method);
 	{
-		char *months[12] = {
+		const char *months[12] = {
 			"January", "February", "March", "April", "May", "June", "July",
 			"August", "September", "October", "November", "December"
 		};
@@ -231,7 +231,7 @@ static int TVCI(FCEUFILE *fp) {
 	if ((t = FCEU_fgetc(fp)) == EOF)
 		return(0);
 	if (t <= 2) {
-		char *stuffo[3] = { "NTSC", "PAL", "NTSC and PAL" };
+		const char *stuffo[3] = { "NTSC", "PAL", "NTSC and PAL" };
 		if (t == 0) {
 			GameInfo->vidsys = GIV_NTSC;
 			FCEUI_SetVidSystem(0);
@@ -260,9 +260,9 @@ static int LoadPRG(FCEUFILE *fp) {
 		return(0);
 	FCEU_printf(" PRG ROM %d size: %d", z, (int)uchead.info);
 	if (malloced[z])
-		free(malloced[z]);
+		FCEU_gfree(malloced[z]);
 	t = FixRomSize(uchead.info, 2048);
-	if (!(malloced[z] = (uint8*)FCEU_malloc(t)))
+	if (!(malloced[z] = (uint8*)FCEU_gtrymalloc(t)))
 		return(0);
 	mallocedsizes[z] = t;
 	memset(malloced[z] + uchead.info, 0xFF, t - uchead.info);
@@ -295,9 +295,9 @@ static int LoadCHR(FCEUFILE *fp) {
 		return(0);
 	FCEU_printf(" CHR ROM %d size: %d", z, (int)uchead.info);
 	if (malloced[16 + z])
-		free(malloced[16 + z]);
+		FCEU_gfree(malloced[16 + z]);
 	t = FixRomSize(uchead.info, 8192);
-	if (!(malloced[16 + z] = (uint8*)FCEU_malloc(t)))
+	if (!(malloced[16 + z] = (uint8*)FCEU_gtrymalloc(t)))
 		return(0);
 	mallocedsizes[16 + z] = t;
 	memset(malloced[16 + z] + uchead.info, 0xFF, t - uchead.info);
@@ -533,7 +533,7 @@ static int InitializeBoard(void) {
 				else
 					CHRRAMSize = 8;
                 CHRRAMSize <<= 10;
-				if ((UNIFchrrama = (uint8*)FCEU_malloc(CHRRAMSize))) {
+				if ((UNIFchrrama = (uint8*)FCEU_gtrymalloc(CHRRAMSize))) {
 					SetupCartCHRMapping(0, UNIFchrrama, CHRRAMSize, 1);
 					AddExState(UNIFchrrama, CHRRAMSize, 0, "CHRR");
 				} else
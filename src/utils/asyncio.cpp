@@ -0,0 +1,113 @@
+/* FCE Ultra - NES/Famicom Emulator
+ *
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation; either version 2 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA  02110-1301  USA
+ */
+
+/// \file
+/// \brief background file writing services provided by FCEU core
+
+#include <stdio.h>
+#include <string>
+#include <deque>
+#include <thread>
+#include <mutex>
+#include <condition_variable>
+#ifndef WIN32
+#include <unistd.h>
+#endif
+
+#include "asyncio.h"
+
+//Never destroyed: the writer thread is still waiting on them when the statics
+//go away at exit, and destroying a condition variable that has a waiter blocks.
+static std::mutex &queueLock = *new std::mutex;
+static std::condition_variable &queueCond = *new std::condition_variable;	//signalled when a job is queued
+static std::condition_variable &idleCond = *new std::condition_variable;	//signalled when the queue drains
+static std::deque<ASYNCJOB*> queue;
+static int pending = 0;		//queued plus running jobs
+static bool started = false;
+
+static void AsyncThread(void)
+{
+	std::unique_lock<std::mutex> lock(queueLock);
+	for(;;)
+	{
+		while(queue.empty())
+			queueCond.wait(lock);
+
+		ASYNCJOB *job = queue.front();
+		queue.pop_front();
+
+		lock.unlock();
+		job->run();
+		delete job;
+		lock.lock();
+
+		if(--pending == 0)
+			idleCond.notify_all();
+	}
+}
+
+void FCEU_AsyncSubmit(ASYNCJOB *job)
+{
+	std::lock_guard<std::mutex> lock(queueLock);
+	if(!started)
+	{
+		//never joined; callers wait for their jobs before exiting
+		std::thread(AsyncThread).detach();
+		started = true;
+	}
+	queue.push_back(job);
+	pending++;
+	queueCond.notify_one();
+}
+
+bool FCEU_AsyncBusy(void)
+{
+	std::lock_guard<std::mutex> lock(queueLock);
+	return pending != 0;
+}
+
+void FCEU_AsyncWait(void)
+{
+	std::unique_lock<std::mutex> lock(queueLock);
+	while(pending)
+		idleCond.wait(lock);
+}
+
+bool FCEU_WriteFileAtomic(const char *path, const void *data, size_t len)
+{
+	std::string tmp = std::string(path) + ".tmp";
+	FILE *fp = fopen(tmp.c_str(), "wb");
+	if(!fp)
+		return false;
+
+	bool ok = fwrite(data, 1, len, fp) == len;
+	ok = fflush(fp) == 0 && ok;
+#ifndef WIN32
+	//the rename must not reach the disk before the data does
+	ok = ok && fsync(fileno(fp)) == 0;
+#endif
+	ok = fclose(fp) == 0 && ok;
+
+#ifdef WIN32
+	if(ok)
+		remove(path);
+#endif
+	ok = ok && rename(tmp.c_str(), path) == 0;
+	if(!ok)
+		remove(tmp.c_str());
+	return ok;
+}
@@ -0,0 +1,31 @@
+#ifndef _ASYNCIO_H_
+#define _ASYNCIO_H_
+
+#include <stddef.h>
+
+//A piece of file work to be done off the emulation thread. Everything the job
+//needs must be copied into it when it is submitted.
+class ASYNCJOB
+{
+public:
+	virtual ~ASYNCJOB() {}
+	//does the work; a job that can fail reports it itself, to whoever
+	//submitted it
+	virtual void run() = 0;
+};
+
+//Queues a job for the background writer thread, which runs jobs one at a time
+//in submission order. Takes ownership of the job.
+void FCEU_AsyncSubmit(ASYNCJOB *job);
+
+//True while submitted jobs have not finished yet
+bool FCEU_AsyncBusy(void);
+
+//Blocks until every submitted job has finished
+void FCEU_AsyncWait(void);
+
+//Writes a whole file to <path>.tmp and renames it over <path>, so a crash or
+//power loss leaves either the old file or the new one, never a partial one.
+bool FCEU_WriteFileAtomic(const char *path, const void *data, size_t len);
+
+#endif
@@ -0,0 +1,231 @@
+/* FCE Ultra - NES/Famicom Emulator
+ *
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation; either version 2 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA  02110-1301  USA
+ */
+
+/// \file
+/// \brief compression services provided by FCEU core
+
+#include <string.h>
+#include "zlib.h"
+#include "codec.h"
+
+// CODEC_LZ stream format: a series of sequences, each made of
+//   token         high nibble literal count, low nibble match length - 4
+//   [length]      if the literal nibble is 15: bytes added to it until one is not 255
+//   literals
+//   offset        2 bytes, little endian, 1..65535 back from the output position
+//   [length]      if the match nibble is 15: extension bytes as above
+// The last sequence stops after its literals.
+
+#define LZ_HASH_BITS	12
+#define LZ_MIN_MATCH	4
+#define LZ_MAX_OFFSET	65535
+
+static inline uint32 LZRead32(const uint8 *p)
+{
+	uint32 v;
+	memcpy(&v, p, 4);
+	return v;
+}
+
+static inline uint32 LZHash(uint32 v)
+{
+	return (v * 2654435761u) >> (32 - LZ_HASH_BITS);
+}
+
+static inline uint8 *LZPutLength(uint8 *op, uint32 len)
+{
+	for(; len >= 255; len -= 255)
+		*op++ = 255;
+	*op++ = (uint8)len;
+	return op;
+}
+
+//Emits one sequence; mlen is 0 for the final, literal only one.
+//Returns NULL if dst would overflow.
+static uint8 *LZPutSequence(uint8 *op, uint8 *oend, const uint8 *lit, uint32 litlen, uint32 offset, uint32 mlen)
+{
+	//token, both length extensions, literals and offset
+	if((uint32)(oend - op) < 1 + (litlen / 255 + 1) + litlen + 2 + (mlen / 255 + 1))
+		return 0;
+
+	uint8 *token = op++;
+	*token = (uint8)((litlen < 15 ? litlen : 15) << 4);
+	if(litlen >= 15)
+		op = LZPutLength(op, litlen - 15);
+	memcpy(op, lit, litlen);
+	op += litlen;
+
+	if(mlen)
+	{
+		*op++ = (uint8)offset;
+		*op++ = (uint8)(offset >> 8);
+		mlen -= LZ_MIN_MATCH;
+		*token |= (uint8)(mlen < 15 ? mlen : 15);
+		if(mlen >= 15)
+			op = LZPutLength(op, mlen - 15);
+	}
+	return op;
+}
+
+static uint32 LZCompress(uint8 *dst, uint32 dstlen, const uint8 *src, uint32 len)
+{
+	uint32 table[1 << LZ_HASH_BITS];
+	memset(table, 0, sizeof(table));
+
+	const uint8 *ip = src, *anchor = src, *end = src + len;
+	uint8 *op = dst, *oend = dst + dstlen;
+
+	while(end - ip >= LZ_MIN_MATCH)
+	{
+		uint32 seq = LZRead32(ip);
+		uint32 h = LZHash(seq);
+		const uint8 *ref = src + table[h];
+		table[h] = (uint32)(ip - src);
+
+		if(ref >= ip || ip - ref > LZ_MAX_OFFSET || LZRead32(ref) != seq)
+		{
+			//step faster through data that doesn't compress
+			ip += 1 + ((ip - anchor) >> 6);
+			continue;
+		}
+
+		const uint8 *mstart = ip;
+		ip += LZ_MIN_MATCH;
+		ref += LZ_MIN_MATCH;
+		while(ip < end && *ip == *ref)
+		{
+			ip++;
+			ref++;
+		}
+
+		op = LZPutSequence(op, oend, anchor, (uint32)(mstart - anchor), (uint32)(ip - ref), (uint32)(ip - mstart));
+		if(!op)
+			return 0;
+		anchor = ip;
+	}
+
+	op = LZPutSequence(op, oend, anchor, (uint32)(end - anchor), 0, 0);
+	if(!op)
+		return 0;
+	return (uint32)(op - dst);
+}
+
+static bool LZGetLength(const uint8 *&ip, const uint8 *iend, uint32 &len)
+{
+	uint8 b;
+	do
+	{
+		if(ip >= iend)
+			return false;
+		b = *ip++;
+		len += b;
+	} while(b == 255);
+	return true;
+}
+
+static bool LZDecompress(uint8 *dst, uint32 dstlen, const uint8 *src, uint32 srclen)
+{
+	const uint8 *ip = src, *iend = src + srclen;
+	uint8 *op = dst, *oend = dst + dstlen;
+
+	while(ip < iend)
+	{
+		uint8 token = *ip++;
+
+		uint32 litlen = token >> 4;
+		if(litlen == 15 && !LZGetLength(ip, iend, litlen))
+			return false;
+		if(litlen > (uint32)(iend - ip) || litlen > (uint32)(oend - op))
+			return false;
+		memcpy(op, ip, litlen);
+		op += litlen;
+		ip += litlen;
+
+		if(ip == iend)
+			break;
+
+		if(iend - ip < 2)
+			return false;
+		uint32 offset = ip[0] | (ip[1] << 8);
+		ip += 2;
+		if(!offset || offset > (uint32)(op - dst))
+			return false;
+
+		uint32 mlen = token & 15;
+		if(mlen == 15 && !LZGetLength(ip, iend, mlen))
+			return false;
+		mlen += LZ_MIN_MATCH;
+		if(mlen > (uint32)(oend - op))
+			return false;
+
+		const uint8 *ref = op - offset;
+		if(offset >= mlen)
+		{
+			memcpy(op, ref, mlen);
+			op += mlen;
+		}
+		else
+		{
+			//overlapping copy repeats the last <offset> bytes
+			while(mlen--)
+				*op++ = *ref++;
+		}
+	}
+	return op == oend;
+}
+
+uint32 FCEU_CodecBound(int codec, uint32 len)
+{
+	if(codec == CODEC_LZ)
+		return len + len / 255 + 16;
+	return compressBound(len);
+}
+
+uint32 FCEU_Compress(int codec, int level, uint8 *dst, uint32 dstlen, const uint8 *src, uint32 len)
+{
+	switch(codec)
+	{
+	case CODEC_ZLIB:
+		{
+			uLongf comprlen = dstlen;
+			if(compress2(dst, &comprlen, src, len, level) != Z_OK)
+				return 0;
+			return comprlen;
+		}
+	case CODEC_LZ:
+		return LZCompress(dst, dstlen, src, len);
+	}
+	return 0;
+}
+
+bool FCEU_Decompress(int codec, uint8 *dst, uint32 dstlen, const uint8 *src, uint32 srclen)
+{
+	switch(codec)
+	{
+	case CODEC_ZLIB:
+		{
+			//zlib reports success for any stream when there is no room at all,
+			//so give it a byte to overflow into
+			uint8 spare;
+			uLongf uncomprlen = dstlen ? dstlen : 1;
+			return uncompress(dstlen ? dst : &spare, &uncomprlen, src, srclen) == Z_OK && uncomprlen == dstlen;
+		}
+	case CODEC_LZ:
+		return LZDecompress(dst, dstlen, src, srclen);
+	}
+	return false;
+}
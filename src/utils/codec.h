@@ -0,0 +1,27 @@
+#ifndef _CODEC_H_
+#define _CODEC_H_
+
+#include "../types.h"
+
+//Compression back ends shared by savestates, movies and rewind.
+//The numbers are stored in files; don't renumber them.
+enum ENUM_CODEC
+{
+	CODEC_ZLIB = 0,	//deflate; what all older savestates use
+	CODEC_LZ = 1,	//in-tree byte aligned LZ77 in the style of LZ4; much faster, larger output
+	CODEC_COUNT
+};
+
+//Largest possible output of FCEU_Compress for len input bytes
+uint32 FCEU_CodecBound(int codec, uint32 len);
+
+//Compresses len bytes from src into dst, which has room for dstlen bytes.
+//level is the zlib level and is ignored by CODEC_LZ. Returns the compressed
+//size, or 0 on failure.
+uint32 FCEU_Compress(int codec, int level, uint8 *dst, uint32 dstlen, const uint8 *src, uint32 len);
+
+//Decompresses srclen bytes from src into dst. Returns true only if the data
+//was valid and produced exactly dstlen bytes.
+bool FCEU_Decompress(int codec, uint8 *dst, uint32 dstlen, const uint8 *src, uint32 srclen);
+
+#endif
@@ -24,26 +24,158 @@
 #include <stdlib.h>
 #include <stdio.h>
 #include <string.h>
+#ifndef WIN32
+#include <sys/mman.h>
+#endif
 #include "../types.h"
 #include "../fceu.h"
 #include "memory.h"
 
-///allocates the specified number of bytes. exits process if this fails
+//The game arena. While a game is open FCEU_gmalloc carves its blocks out of
+//large chunks instead of going to the heap, and FCEU_ArenaRelease hands all of
+//them back at once when the game closes. Close hooks may still free their
+//buffers: that only takes the block back if it was the last one allocated.
+//Chunks are whole multiples of a 2MB huge page and are mapped, not malloced,
+//so switching games doesn't leave the heap fragmented and the pages a small
+//game never touches are never committed.
+#define ARENA_ALIGN	64			//cache line, and wide enough for any SIMD loads
+#define ARENA_CHUNK	(2 << 20)
+
+struct ArenaChunk
+{
+	ArenaChunk *next;
+	uint32 size;	//of the whole mapping
+	uint32 used;	//offset of the free space
+	uint32 dirty;	//everything past this is still zero from the mapping
+	uint32 last;	//offset of the last block, for taking it back
+};
+
+#define ARENA_HEADER	((sizeof(ArenaChunk) + ARENA_ALIGN - 1) & ~(ARENA_ALIGN - 1))
+
+static ArenaChunk *arena = 0;	//newest chunk first
+static bool arenaOpen = false;
+
+static ArenaChunk *ArenaMap(uint32 size)
+{
+#ifdef WIN32
+	void *p = calloc(1, size);
+	if(!p) return 0;
+#else
+	void *p = mmap(0, size, PROT_READ | PROT_WRITE, MAP_PRIVATE | MAP_ANONYMOUS, -1, 0);
+	if(p == MAP_FAILED) return 0;
+#ifdef MADV_HUGEPAGE
+	madvise(p, size, MADV_HUGEPAGE);
+#endif
+#endif
+	ArenaChunk *c = (ArenaChunk*)p;
+	c->size = size;
+	c->used = c->dirty = c->last = ARENA_HEADER;
+	return c;
+}
+
+static void ArenaUnmap(ArenaChunk *c)
+{
+#ifdef WIN32
+	free(c);
+#else
+	munmap(c, c->size);
+#endif
+}
+
+static void *ArenaAlloc(uint32 size)
+{
+	uint32 len = (size + ARENA_ALIGN - 1) & ~(ARENA_ALIGN - 1);
+	if(len < size) return 0;
+	//a zero sized block still gets room: otherwise it would share its address
+	//with the next block, and one at the end of a chunk would point past it
+	//and be handed to free()
+	if(!len) len = ARENA_ALIGN;
+
+	if(!arena || arena->size - arena->used < len)
+	{
+		uint64 want = (uint64)ARENA_HEADER + len;
+		want = (want + ARENA_CHUNK - 1) & ~(uint64)(ARENA_CHUNK - 1);
+		if(want > 0xFFFFFFFF) return 0;
+		ArenaChunk *c = ArenaMap((uint32)want);
+		if(!c) return 0;
+		c->next = arena;
+		arena = c;
+	}
+
+	uint8 *ret = (uint8*)arena + arena->used;
+	//memory given back and handed out again has to be cleared like the heap's
+	if(arena->used < arena->dirty)
+		memset(ret, 0, (arena->dirty < arena->used + len ? arena->dirty : arena->used + len) - arena->used);
+	arena->last = arena->used;
+	arena->used += len;
+	if(arena->dirty < arena->used)
+		arena->dirty = arena->used;
+	return ret;
+}
+
+//Returns true if ptr belongs to the arena, taking it back if it was the last block.
+static bool ArenaFree(void *ptr)
+{
+	for(ArenaChunk *c = arena; c; c = c->next)
+	{
+		uint8 *base = (uint8*)c;
+		if((uint8*)ptr < base || (uint8*)ptr >= base + c->size)
+			continue;
+		if(c == arena && (uint8*)ptr == base + c->last)
+			c->used = c->last;
+		return true;
+	}
+	return false;
+}
+
+///starts the arena for a game about to be loaded, dropping any previous one
+void FCEU_ArenaOpen(void)
+{
+	FCEU_ArenaRelease();
+	arenaOpen = true;
+}
+
+///frees everything allocated from the arena since FCEU_ArenaOpen in one go
+void FCEU_ArenaRelease(void)
+{
+	while(arena)
+	{
+		ArenaChunk *next = arena->next;
+		ArenaUnmap(arena);
+		arena = next;
+	}
+	arenaOpen = false;
+}
+
+///allocates the specified number of zeroed bytes, from the arena while a game is open.
+///returns null if this fails
+void *FCEU_gtrymalloc(uint32 size)
+{
+	if(!arenaOpen)
+	{
+		void *ret = malloc(size);
+		if(ret)
+			memset(ret, 0, size);
+		return ret;
+	}
+	return ArenaAlloc(size);
+}
+
+///allocates the specified number of bytes, from the arena while a game is open. exits process if this fails
 void *FCEU_gmalloc(uint32 size)
 {
 	
  void *ret;
- ret=malloc(size);
+ //mbg 6/17/08 - sometimes this memory is used as RAM or somesuch without clearing first.
+ //this yields different behavior in debug and release modes.
+ //specifically, saveram wasnt getting cleared so the games thought their savefiles were initialized
+ //so FCEU_gtrymalloc clears it.
+ ret=FCEU_gtrymalloc(size);
  if(!ret)  
  {
   FCEU_PrintError("Error allocating memory!  Doing a hard exit.");
   exit(1);
  }
- //mbg 6/17/08 - sometimes this memory is used as RAM or somesuch without clearing first.
- //this yields different behavior in debug and release modes.
- //specifically, saveram wasnt getting cleared so the games thought their savefiles were initialized
- //so we are going to clear it here.
- memset(ret,0,size);
  return ret;
 }
 
@@ -65,16 +197,18 @@ void *FCEU_malloc(uint32 size)
  return ret;
 }
 
-///frees memory allocated with FCEU_gmalloc
+///frees memory allocated with FCEU_gmalloc or FCEU_gtrymalloc
 void FCEU_gfree(void *ptr)
 {
- free(ptr);
+ if(!ArenaFree(ptr))
+  free(ptr);
 }
 
 ///frees memory allocated with FCEU_malloc
 void FCEU_free(void *ptr)    // Might do something with this and FCEU_malloc later...
 {
- free(ptr);
+ if(!ArenaFree(ptr))
+  free(ptr);
 }
 
 void *FCEU_dmalloc(uint32 size)
@@ -26,10 +26,16 @@
 
 void *FCEU_malloc(uint32 size);
 void *FCEU_gmalloc(uint32 size);
+void *FCEU_gtrymalloc(uint32 size);
 void FCEU_gfree(void *ptr);
 void FCEU_free(void *ptr);
 void FCEU_memmove(void *d, void *s, uint32 l);
 
+// the game arena: between these two FCEU_gmalloc and FCEU_gtrymalloc
+// allocate from it, and closing the game frees all of it in one call
+void FCEU_ArenaOpen(void);
+void FCEU_ArenaRelease(void);
+
 // wrapper for debugging when its needed, otherwise act like
 // normal malloc/free
 void *FCEU_dmalloc(uint32 size);
@@ -32,6 +32,7 @@
 #include "vsuni.h"
 #include "drawing.h"
 #include "driver.h"
+#include "runahead.h"
 #include "drivers/common/vidblit.h"
 #ifdef _S9XLUA_H
 #include "fceulua.h"
@@ -63,12 +64,16 @@
 //128-195 is the palette with no emphasis
 //196-255 is the palette with all emphasis bits on
 u8 *XBuf=NULL; //used for current display
-u8 *XBackBuf=NULL; //ppu output is stashed here before drawing happens
+u8 *XBackBuf=NULL; //ppu output is stashed here before drawing happens, see FCEU_BeginOverlay()
 u8 *XDBuf=NULL; //corresponding to XBuf but with deemph bits
 u8 *XDBackBuf=NULL; //corresponding to XBackBuf but with deemph bits
 int ClipSidesOffset=0;	//Used to move displayed messages when Clips left and right sides is checked
 static u8 *xbsave=NULL;
 
+static bool BackBufValid=false; //XBackBuf holds the current frame; until then XBuf has no overlays
+
+void (*FCEU_LineHook)(int line, uint8 *row)=NULL; //driver line output, see FCEUI_SetLineHook()
+
 GUIMESSAGE guiMessage;
 GUIMESSAGE subtitleMessage;
 
@@ -144,9 +149,57 @@ int FCEU_InitVirtualVideo(void)
 	return 1;
 }
 
+void FCEUI_SetLineHook(void (*hook)(int line, uint8 *row))
+{
+	FCEU_LineHook=hook;
+}
+
+//Hands the rows changed by the overlays back to the driver
+static void ReemitOverlayLines(void)
+{
+	if(FCEU_LineHook && BackBufValid && !FCEUI_EmulationPaused())
+	{
+		for(int y=0; y<240; y++)
+			if(memcmp(XBuf+(y<<8), XBackBuf+(y<<8), 256))
+				FCEU_LineHook(y, XBuf+(y<<8));
+	}
+}
+
+//The back buffer is copy-on-write: most frames have no overlays, so XBuf itself is the
+//clean frame and nothing is copied. Anything that draws into XBuf calls this first.
+void FCEU_BeginOverlay(void)
+{
+	if(!BackBufValid)
+	{
+		memcpy(XBackBuf, XBuf, 256*256);
+		BackBufValid=true;
+	}
+}
+
+//Returns the current frame without overlays (for savestates, Lua, ...)
+uint8 *FCEU_GetBackBuf(void)
+{
+	return BackBufValid ? XBackBuf : XBuf;
+}
+
+//Called after XBackBuf was filled from elsewhere (savestate load, power, reset)
+void FCEU_BackBufLoaded(void)
+{
+	BackBufValid=true;
+}
+
+//Removes the overlays from XBuf, so they can be redrawn while paused
+void FCEU_RestoreBackBuf(void)
+{
+	if(BackBufValid)
+		memcpy(XBuf, XBackBuf, 256*256);
+}
+
 #ifdef FRAMESKIP
 void FCEU_PutImageDummy(void)
 {
+	//The PPU didn't draw this frame, so XBuf still holds the last one with its
+	//overlays, and the back buffer stays what it was.
 	ShowFPS();
 	if(GameInfo->type!=GIT_NSF)
 	{
@@ -154,7 +207,7 @@ void FCEU_PutImageDummy(void)
 		FCEU_DrawSaveStates(XBuf);
 		FCEU_DrawMovies(XBuf);
 	}
-	if(guiMessage.howlong) guiMessage.howlong--; /* DrawMessage() */
+	if(guiMessage.howlong && !FCEU_RunAheadSpeculating()) guiMessage.howlong--; /* DrawMessage() */
 }
 #endif
 
@@ -196,6 +249,7 @@ void FCEU_PutImage(void)
 		DrawNSF(XBuf);
 
 #ifdef _S9XLUA_H
+		FCEU_BeginOverlay();
 		FCEU_LuaGui(XBuf);
 #endif
 
@@ -208,15 +262,16 @@ void FCEU_PutImage(void)
 	}
 	else
 	{
-		//Save backbuffer before overlay stuff is written.
+		//New frame from the PPU: it is copied to the backbuffer only once an overlay gets drawn.
 		if(!FCEUI_EmulationPaused())
-			memcpy(XBackBuf, XBuf, 256*256);
+			BackBufValid=false;
 
 		//Some messages need to be displayed before the avi is dumped
 		DrawMessage(true);
 
 #ifdef _S9XLUA_H
 		// Lua gui should draw before the avi is dumped.
+		FCEU_BeginOverlay();
 		FCEU_LuaGui(XBuf);
 #endif
 
@@ -241,7 +296,10 @@ void FCEU_PutImage(void)
 	}
 
 	if(FCEUD_ShouldDrawInputAids())
+	{
+		FCEU_BeginOverlay();
 		FCEU_DrawInput(XBuf);
+	}
 
 	//Fancy input display code
 	if(input_display)
@@ -257,6 +315,8 @@ void FCEU_PutImage(void)
 		uint32 ahold = 0x87;		//Auto hold
 		uint32 off = 0xCF;
 
+		FCEU_BeginOverlay();
+
 		uint8 *t = XBuf+(FSettings.LastSLine-9)*256 + 20;		//mbg merge 7/17/06 changed t to uint8*
 		if(input_display > 4) input_display = 4;
 		for(controller = 0; controller < input_display; controller++, t += 56)
@@ -436,6 +496,7 @@ void FCEU_PutImage(void)
 		}
 	} else DrawMessage(false);
 
+	ReemitOverlayLines();
 }
 void snapAVI()
 {
@@ -444,7 +505,7 @@ void snapAVI()
 		FCEUI_AviVideoUpdate(XBuf);
 }
 
-void FCEU_DispMessageOnMovie(char *format, ...)
+void FCEU_DispMessageOnMovie(const char *format, ...)
 {
 	va_list ap;
 
@@ -460,7 +521,7 @@ void FCEU_DispMessageOnMovie(char *format, ...)
 		guiMessage.howlong = 0;
 }
 
-void FCEU_DispMessage(char *format, int disppos=0, ...)
+void FCEU_DispMessage(const char *format, int disppos=0, ...)
 {
 	va_list ap;
 
@@ -501,7 +562,7 @@ void FCEU_ResetMessages()
 }
 
 
-static int WritePNGChunk(FILE *fp, uint32 size, char *type, uint8 *data)
+static int WritePNGChunk(FILE *fp, uint32 size, const char *type, uint8 *data)
 {
 	uint32 crc;
 
@@ -543,7 +604,7 @@ uint32 GetScreenPixel(int x, int y, bool usebackup) {
 		return -1;
 
 	if (usebackup)
-		FCEUD_GetPalette(XBackBuf[(y*256)+x],&r,&g,&b);
+		FCEUD_GetPalette(FCEU_GetBackBuf()[(y*256)+x],&r,&g,&b);
 	else
 		FCEUD_GetPalette(XBuf[(y*256)+x],&r,&g,&b);
 
@@ -557,7 +618,7 @@ int GetScreenPixelPalette(int x, int y, bool usebackup) {
 		return -1;
 
 	if (usebackup)
-		return XBackBuf[(y*256)+x] & 0x3f;
+		return FCEU_GetBackBuf()[(y*256)+x] & 0x3f;
 	else
 		return XBuf[(y*256)+x] & 0x3f;
 
@@ -819,10 +880,13 @@ void ShowFPS(void)
 	uint64 da = FCEUD_GetTime() - boop[boopcount];
 	char fpsmsg[16];
 	int booplimit = PAL?50:60;
-	boop[boopcount] = FCEUD_GetTime();
 
 	sprintf(fpsmsg, "%.1f", (double)booplimit / ((double)da / FCEUD_GetTimeFreq()));
 	DrawTextTrans(XBuf + ((256 - ClipSidesOffset) - 40) + (FSettings.FirstSLine + 4) * 256, 256, (uint8*)fpsmsg, 0xA0);
+	//only real frames count, not the ones run ahead
+	if(FCEU_RunAheadSpeculating())
+		return;
+	boop[boopcount] = FCEUD_GetTime();
 	// It's not averaging FPS over exactly 1 second, but it's close enough.
 	boopcount = (boopcount + 1) % booplimit;
 }
@@ -12,6 +12,11 @@ extern uint8 *XBackBuf;
 extern uint8 *XDBuf;
 extern uint8 *XDBackBuf;
 extern int ClipSidesOffset;
+extern void (*FCEU_LineHook)(int line, uint8 *row);
+void FCEU_BeginOverlay(void);
+uint8 *FCEU_GetBackBuf(void);
+void FCEU_BackBufLoaded(void);
+void FCEU_RestoreBackBuf(void);
 extern struct GUIMESSAGE
 {
 	//countdown for gui messages
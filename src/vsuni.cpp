@@ -26,6 +26,7 @@
 #include "vsuni.h"
 #include "state.h"
 #include "driver.h"
+#include "video.h"
 
 #include <cstring>
 #include <cstdio>
@@ -35,7 +36,7 @@
 
 #define IOPTION_PREDIP    0x10
 typedef struct {
-	char *name;
+	const char *name;
 	uint64 md5partial;
 	int mapper;
 	int mirroring;
@@ -342,6 +343,7 @@ void FCEU_VSUniDraw(uint8 *XBuf) {
 	int y, x;
 
 	if (!DIPS) return;
+	FCEU_BeginOverlay();
 
 	dest = (uint32*)(XBuf + 256 * 12 + 164);
 	for (y = 24; y; y--, dest += (256 - 72) >> 2) {